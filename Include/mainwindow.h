@@ -9,6 +9,13 @@
 #include <QTimer>
 #include <QTextEdit>
 #include <QComboBox>
+#include <QAbstractTableModel>
+#include <QTableView>
+#include <QHeaderView>
+#include <QSlider>
+#include <QPixmap>
+#include <QPen>
+#include <QBrush>
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QSqlError>
@@ -23,12 +30,24 @@
 #include <QDateTime>
 #include <QFileInfo>
 #include <QCoreApplication>
+#include <QtAlgorithms>
+#include <QMutex>
+#include <QThread>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QJsonObject>
+#include <QJsonArray>
 #include <chrono>
 #include <vector>
 #include <QString>
 #include <string>
 #include <fstream>
 #include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <functional>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -39,129 +58,807 @@ QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
 
+// --- ResourceUsage Struct ---
+// One sample of process and system resources. CPU percentages cover the
+// time since the previous sample; process CPU is relative to one core.
+struct ResourceUsage {
+    double rssMB = 0.0;
+    double peakRssMB = 0.0;
+    double processCpuPercent = 0.0;
+    double systemCpuPercent = 0.0;
+    quint64 voluntaryContextSwitches = 0;
+    quint64 involuntaryContextSwitches = 0;
+    quint64 minorPageFaults = 0;
+    quint64 majorPageFaults = 0;
+};
+
+// --- LatencyHistogram Class ---
+// Fixed-size log-linear (HDR-style) histogram of durations. Values are
+// bucketed in microseconds, exact below 64 us and within ~3% above, up to
+// ~19 hours. Recording is O(1); percentile queries walk a fixed number of
+// buckets regardless of how many samples were recorded.
+class LatencyHistogram {
+public:
+    static const int SubBucketCount = 32;
+    static const int MaxExponent = 36;
+    static const int BucketCount = 2 * SubBucketCount + (MaxExponent - 5) * SubBucketCount;
+
+    LatencyHistogram() : counts(newCounts()) {}
+
+    void record(double ms) {
+        quint64 us = ms > 0.0 ? static_cast<quint64>(ms * 1000.0 + 0.5) : 0;
+        counts[bucketIndex(us)]++;
+        if (totalCount == 0 || ms < minValue) minValue = ms;
+        if (totalCount == 0 || ms > maxValue) maxValue = ms;
+        totalCount++;
+        sum += ms;
+    }
+    quint64 getCount() const { return totalCount; }
+    double getSum() const { return sum; }
+    double getMean() const { return totalCount ? sum / totalCount : 0.0; }
+    double getMin() const { return minValue; }
+    double getMax() const { return maxValue; }
+    double getPercentile(double percentile) const;
+    quint64 countAtOrBelow(double ms) const;
+    quint64 getBucketCount(int index) const { return counts[index]; }
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    static int bucketIndex(quint64 us) {
+        if (us < 2 * SubBucketCount)
+            return static_cast<int>(us);
+        int msb = 63 - qCountLeadingZeroBits(us);
+        if (msb > MaxExponent)
+            return BucketCount - 1;
+        int shift = msb - 5;
+        return 2 * SubBucketCount + (msb - 6) * SubBucketCount + static_cast<int>((us >> shift) - SubBucketCount);
+    }
+    static quint64 bucketLowerBound(int index) {
+        if (index < 2 * SubBucketCount)
+            return static_cast<quint64>(index);
+        int octave = (index - 2 * SubBucketCount) / SubBucketCount;
+        quint64 sub = (index - 2 * SubBucketCount) % SubBucketCount + SubBucketCount;
+        return sub << (octave + 1);
+    }
+    static quint64 bucketUpperBound(int index) {
+        if (index < 2 * SubBucketCount)
+            return static_cast<quint64>(index);
+        int octave = (index - 2 * SubBucketCount) / SubBucketCount;
+        return bucketLowerBound(index) + (quint64(1) << (octave + 1)) - 1;
+    }
+
+private:
+    static std::vector<quint64> newCounts();
+    std::vector<quint64> counts;
+    quint64 totalCount = 0;
+    double sum = 0.0;
+    double minValue = 0.0;
+    double maxValue = 0.0;
+};
+
+// --- ProbeEventBuffer Class ---
+// Timing probes write fixed-size events into a per-thread ring buffer
+// without locks. A single consumer drains every thread's buffer later for
+// aggregation or export; when a writer laps the consumer the oldest events
+// are dropped and counted.
+struct ProbeEvent {
+    const char* name;         // string literal, never freed
+    qint64 startNs;           // steady clock
+    qint64 durationNs;
+    int threadIndex;
+};
+
+class ProbeEventBuffer {
+public:
+    static const quint64 Capacity = 4096;   // power of two; holds Capacity - 1 events
+
+    static qint64 nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    static ProbeEventBuffer& local();
+
+    void record(const char* name, qint64 startNs, qint64 durationNs) {
+        quint64 position = head.load(std::memory_order_relaxed);
+        ProbeEvent& event = events[position & (Capacity - 1)];
+        event.name = name;
+        event.startNs = startNs;
+        event.durationNs = durationNs;
+        event.threadIndex = threadIndex;
+        head.store(position + 1, std::memory_order_release);
+    }
+
+    // Consumer side, serialized internally.
+    static std::vector<ProbeEvent> drainAll();
+    static quint64 getDroppedEventCount();
+
+    explicit ProbeEventBuffer(int index) : events(Capacity), head(0), threadIndex(index) {}
+
+private:
+    std::vector<ProbeEvent> events;
+    std::atomic<quint64> head;
+    quint64 tail = 0;                       // consumer-owned
+    int threadIndex;
+    std::atomic<bool> threadExited{false};
+    friend struct ProbeThreadRegistration;
+};
+
+// --- AllocationTracker Class ---
+// Opt-in heap accounting (build with TICTACTOE_ALLOC_TRACKING). The global
+// operator new/delete are replaced; every block gets a 16-byte header with
+// its size and the subsystem that was active on the allocating thread, so
+// frees are charged back to the right subsystem. Counters are relaxed
+// atomics. Not available on Windows, where Qt DLLs bring their own heap.
+#if defined(TICTACTOE_ALLOC_TRACKING) && !defined(_WIN32)
+#define TICTACTOE_ALLOC_TRACKING_ACTIVE
+#endif
+
+struct AllocationStats {
+    quint64 liveBytes = 0;
+    quint64 peakBytes = 0;
+    quint64 allocations = 0;
+    quint64 deallocations = 0;
+    quint64 totalBytes = 0;
+};
+
+class AllocationTracker {
+public:
+    enum Subsystem { Untagged, GameHistory, Monitoring, Widgets, AiSearch, Database, SubsystemCount };
+
+    static bool isEnabled();
+    static const char* subsystemName(Subsystem subsystem);
+    static AllocationStats getStats(Subsystem subsystem);
+    static Subsystem exchangeCurrent(Subsystem subsystem);   // returns the previous tag
+};
+
+// Charges allocations made on this thread to a subsystem until the scope
+// ends; scopes nest.
+class AllocationScope {
+public:
+#ifdef TICTACTOE_ALLOC_TRACKING_ACTIVE
+    explicit AllocationScope(AllocationTracker::Subsystem subsystem)
+        : previous(AllocationTracker::exchangeCurrent(subsystem)) {}
+    ~AllocationScope() { AllocationTracker::exchangeCurrent(previous); }
+#else
+    explicit AllocationScope(AllocationTracker::Subsystem) {}
+#endif
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+#ifdef TICTACTOE_ALLOC_TRACKING_ACTIVE
+private:
+    AllocationTracker::Subsystem previous;
+#endif
+};
+
 // --- Performance Monitor Class ---
 class PerformanceMonitor {
 private:
     QElapsedTimer timer;
-    std::vector<double> measurements;
+    LatencyHistogram histogram;
     QString operationName;
 
+    // Optional rolling window: a ring of histograms, one per time slice.
+    std::vector<LatencyHistogram> windowSlices;
+    std::vector<qint64> windowSliceEpochs;
+    qint64 windowSliceMs = 0;
+
 public:
     PerformanceMonitor(const QString& name = "") : operationName(name) {}
 
     void startMeasurement() { timer.start(); }
     double stopMeasurement() {
         double elapsed = timer.nsecsElapsed() / 1000000.0;
-        measurements.push_back(elapsed);
-        qDebug() << operationName << "execution time:" << elapsed << "ms";
+        addMeasurement(elapsed);
         return elapsed;
     }
-    double getAverageTime() const {
-        if (measurements.empty()) return 0.0;
-        double sum = 0.0;
-        for (double time : measurements) sum += time;
-        return sum / measurements.size();
-    }
-    double getMaxTime() const {
-        if (measurements.empty()) return 0.0;
-        return *std::max_element(measurements.begin(), measurements.end());
+    double getAverageTime() const { return histogram.getMean(); }
+    double getMaxTime() const { return histogram.getMax(); }
+    double getMinTime() const { return histogram.getMin(); }
+    void addMeasurement(double elapsed) {
+        histogram.record(elapsed);
+        if (windowSliceMs > 0)
+            recordInWindow(elapsed);
     }
-    double getMinTime() const {
-        if (measurements.empty()) return 0.0;
-        return *std::min_element(measurements.begin(), measurements.end());
-    }
-    size_t getMeasurementCount() const { return measurements.size(); }
+    // Percentile in [0, 100] over every measurement since construction.
+    double getPercentile(double percentile) const { return histogram.getPercentile(percentile); }
+    const LatencyHistogram& getHistogram() const { return histogram; }
+    const QString& getName() const { return operationName; }
+    size_t getMeasurementCount() const { return static_cast<size_t>(histogram.getCount()); }
+
+    // Rolling-window mode keeps the last windowMs of measurements in
+    // sliceCount slices, in addition to the lifetime histogram.
+    void setRollingWindow(qint64 windowMs, int sliceCount = 6);
+    LatencyHistogram getWindowHistogram() const;
+    double getWindowPercentile(double percentile) const { return getWindowHistogram().getPercentile(percentile); }
+
+    // Logging is kept out of the measurement path; call this when a
+    // summary is wanted.
+    QString getSummary() const;
+    void logSummary() const { qDebug().noquote() << getSummary(); }
+    static std::map<QString, LatencyHistogram> aggregateProbeEvents(const std::vector<ProbeEvent>& events);
+
     void saveToFile(const QString& filename) const {
         std::ofstream file(filename.toStdString());
         file << "Operation: " << operationName.toStdString() << "\n";
-        file << "Total measurements: " << measurements.size() << "\n";
+        file << "Total measurements: " << histogram.getCount() << "\n";
         file << "Average time: " << getAverageTime() << " ms\n";
         file << "Maximum time: " << getMaxTime() << " ms\n";
         file << "Minimum time: " << getMinTime() << " ms\n";
+        file << "p50/p90/p99/p999: " << getPercentile(50) << " / " << getPercentile(90) << " / "
+             << getPercentile(99) << " / " << getPercentile(99.9) << " ms\n";
         file.close();
     }
-    // Windows Performance Monitoring
+    // System Resource Monitoring (Windows and Linux)
     static double getCurrentMemoryUsageMB();
     static double getCPUUsagePercent();
+    static ResourceUsage sampleResourceUsage();
+    static QString getAllocationReport();
 private:
 #ifdef _WIN32
     static ULONGLONG lastIdleTime;
     static ULONGLONG lastKernelTime;
     static ULONGLONG lastUserTime;
+#elif defined(__linux__)
+    static quint64 lastSystemTotalTicks;
+    static quint64 lastSystemIdleTicks;
+    static quint64 lastProcessTicks;
+    static qint64 lastProcessSampleNs;
 #endif
+    void recordInWindow(double elapsed);
 };
 
-// --- Game Metrics Class ---
-class GameMetrics {
+// --- ScopedProbe Class ---
+// RAII timing probe: records a ProbeEvent for the enclosing scope and,
+// optionally, a measurement in a PerformanceMonitor. stop() ends it early.
+// Defining TICTACTOE_DISABLE_PROBES turns every probe into a no-op.
+class ScopedProbe {
+public:
+#ifndef TICTACTOE_DISABLE_PROBES
+    explicit ScopedProbe(const char* name, PerformanceMonitor* monitor = nullptr)
+        : name(name), monitor(monitor), startNs(ProbeEventBuffer::nowNs()) {}
+    ~ScopedProbe() { stop(); }
+    double stop() {
+        if (!name)
+            return 0.0;
+        qint64 durationNs = ProbeEventBuffer::nowNs() - startNs;
+        ProbeEventBuffer::local().record(name, startNs, durationNs);
+        double elapsed = durationNs / 1000000.0;
+        if (monitor)
+            monitor->addMeasurement(elapsed);
+        name = nullptr;
+        return elapsed;
+    }
+#else
+    explicit ScopedProbe(const char*, PerformanceMonitor* = nullptr) {}
+    double stop() { return 0.0; }
+#endif
+    ScopedProbe(const ScopedProbe&) = delete;
+    ScopedProbe& operator=(const ScopedProbe&) = delete;
+#ifndef TICTACTOE_DISABLE_PROBES
 private:
-    int totalGames;
-    int playerWins;
-    int aiWins;
-    int draws;
-    std::vector<double> gameDurations;
-    PerformanceMonitor gameTimer;
+    const char* name;
+    PerformanceMonitor* monitor;
+    qint64 startNs;
+#endif
+};
+
+// --- TraceRecorder Class ---
+// Collects probe events for the session and writes them as Chrome trace
+// JSON, which chrome://tracing and ui.perfetto.dev can open. Recording is
+// off until an output file is set (TICTACTOE_TRACE_FILE at startup).
+class TraceRecorder {
 public:
-    GameMetrics() : totalGames(0), playerWins(0), aiWins(0), draws(0), gameTimer("Game Duration") {}
-    void startGame() { gameTimer.startMeasurement(); }
-    void endGame(const QString& winner) {
-        double duration = gameTimer.stopMeasurement();
-        gameDurations.push_back(duration);
-        totalGames++;
+    static void setOutputFile(const QString& path);
+    static QString getOutputFile();
+    static bool isEnabled();
+
+    // Moves pending probe events into the session; call between games so
+    // the per-thread rings do not wrap.
+    static void collect();
+    static size_t getEventCount();
+    static bool flush();    // collect() and rewrite the output file
+
+    static QByteArray toChromeTrace(const std::vector<ProbeEvent>& events);
+    static bool writeChromeTrace(const QString& path, const std::vector<ProbeEvent>& events);
+};
+
+// --- MetricsServer Class ---
+// Minimal HTTP server on localhost that answers GET /metrics with the
+// registered counters and histograms in the Prometheus text format.
+// Metric sources are read on the thread that owns the server.
+class MetricsServer : public QObject {
+    Q_OBJECT
+public:
+    explicit MetricsServer(QObject* parent = nullptr);
+    ~MetricsServer();
+
+    bool start(quint16 port = 0);   // 0 picks a free port
+    void stop();
+    bool isListening() const;
+    quint16 serverPort() const;
+
+    // Metrics sharing a name are grouped under one HELP/TYPE header and
+    // told apart by labels, e.g. operation="insert_game".
+    void addCounter(const QString& name, const QString& help, std::function<double()> value,
+                    const QString& labels = QString());
+    void addGauge(const QString& name, const QString& help, std::function<double()> value,
+                  const QString& labels = QString());
+    void addHistogram(const QString& name, const QString& help, std::function<LatencyHistogram()> histogram,
+                      const QString& labels = QString());
+    QString render() const;
+
+    // Latency buckets, in seconds, exported for every histogram.
+    static const std::vector<double>& bucketBoundsSeconds();
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+
+private:
+    struct Metric {
+        QString name;
+        QString help;
+        QString labels;
+        std::function<double()> counter;    // also used for gauges
+        std::function<LatencyHistogram()> histogram;
+        bool gauge = false;
+    };
+    QTcpServer* server;
+    std::vector<Metric> metrics;
+};
+
+// --- RunningStats Struct ---
+// Welford's online mean and variance: constant memory however many values
+// are added.
+struct RunningStats {
+    quint64 count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;          // sum of squared deviations from the mean
+    double min = 0.0;
+    double max = 0.0;
+
+    void add(double value) {
+        if (count == 0 || value < min) min = value;
+        if (count == 0 || value > max) max = value;
+        count++;
+        double delta = value - mean;
+        mean += delta / count;
+        m2 += delta * (value - mean);
+    }
+    double getVariance() const { return count > 1 ? m2 / (count - 1) : 0.0; }
+    double getStdDev() const { return std::sqrt(getVariance()); }
+};
+
+// --- GameOutcomeStats Struct ---
+struct GameOutcomeStats {
+    int games = 0;
+    int playerWins = 0;
+    int aiWins = 0;
+    int draws = 0;
+    RunningStats durationMs;
+
+    void add(const QString& winner, double duration) {
+        games++;
         if (winner == "You" || winner == "Player 1" || winner == "Player 2") playerWins++;
         else if (winner == "AI") aiWins++;
         else draws++;
+        durationMs.add(duration);
     }
-    double getAverageGameDuration() const {
-        if (gameDurations.empty()) return 0.0;
-        double sum = 0.0;
-        for (double duration : gameDurations) sum += duration;
-        return sum / gameDurations.size();
+};
+
+// --- GameContext Struct ---
+// What a finished game is broken down by; empty fields are not counted.
+struct GameContext {
+    QString mode;             // PvP, PvAI
+    QString aiStrategy;       // minimax, none
+    int boardSize = 3;
+    QString user;
+};
+
+// --- Game Metrics Class ---
+// Each game is counted once, into the totals and into one bucket per
+// breakdown dimension. endGame() without a matching startGame() is ignored.
+class GameMetrics {
+public:
+    enum Dimension { ByMode, ByAiStrategy, ByBoardSize, ByUser, DimensionCount };
+
+    void startGame() { gameTimer.start(); gameInProgress = true; }
+    bool endGame(const QString& winner, const GameContext& context = GameContext()) {
+        if (!gameInProgress)
+            return false;
+        gameInProgress = false;
+        recordGame(winner, gameTimer.nsecsElapsed() / 1000000.0, context);
+        return true;
     }
-    int getTotalGames() const { return totalGames; }
-    int getPlayerWins() const { return playerWins; }
-    int getAiWins() const { return aiWins; }
-    int getDraws() const { return draws; }
+    bool isGameInProgress() const { return gameInProgress; }
+    void recordGame(const QString& winner, double durationMs, const GameContext& context);
+
+    double getAverageGameDuration() const { return totals.durationMs.mean; }
+    int getTotalGames() const { return totals.games; }
+    int getPlayerWins() const { return totals.playerWins; }
+    int getAiWins() const { return totals.aiWins; }
+    int getDraws() const { return totals.draws; }
+    const GameOutcomeStats& getTotals() const { return totals; }
+    const std::map<QString, GameOutcomeStats>& getBreakdown(Dimension dimension) const { return breakdowns[dimension]; }
+
+    // Persistence keys: ("total", "") for the totals, otherwise the
+    // dimension name and the bucket key, e.g. ("mode", "PvAI").
+    static QString dimensionName(Dimension dimension);
+    static QString dimensionKey(Dimension dimension, const GameContext& context);
+    void setStats(const QString& dimension, const QString& key, const GameOutcomeStats& stats);
+    void reset();
+
+private:
+    GameOutcomeStats totals;
+    std::map<QString, GameOutcomeStats> breakdowns[DimensionCount];
+    QElapsedTimer gameTimer;
+    bool gameInProgress = false;
+};
+
+// --- MetricsExporter Class ---
+// Appends machine-readable snapshots of the performance monitors and game
+// metrics to a file, one session after another. A session starts with a
+// metadata record (build, platform, configuration); every snapshot after
+// it carries a timestamp so successive snapshots form a time series.
+// Files ending in .csv get CSV rows, anything else JSON Lines. Writes are
+// serialized, so snapshots may be appended from any thread.
+class MetricsExporter {
+public:
+    enum Format { JsonLines, Csv };
+
+    explicit MetricsExporter(const QString& path);
+    MetricsExporter(const QString& path, Format format);
+
+    bool beginSession(const QJsonObject& config = QJsonObject());
+    bool appendSnapshot(const std::vector<PerformanceMonitor>& monitors, const GameMetrics& metrics);
+
+    const QString& getPath() const { return path; }
+    Format getFormat() const { return format; }
+    const QString& getSessionId() const { return sessionId; }
+
+    static Format formatForPath(const QString& path);
+    static QJsonObject buildMetadata();
+    static QJsonObject monitorToJson(const PerformanceMonitor& monitor);
+    static QJsonObject gameMetricsToJson(const GameMetrics& metrics);
+    static QString csvHeader();
+
+private:
+    bool appendLines(const QByteArray& lines);
+    QString csvRow(const QString& timestamp, const QString& kind, const QString& name,
+                   const QString& value, const PerformanceMonitor* monitor = nullptr, quint64 count = 0) const;
+
+    QString path;
+    Format format;
+    QString sessionId;
+    QMutex writeMutex;   // guards sequence and the file
+    int sequence = 0;
 };
 
 // --- Move Struct ---
-struct Move { int row; int col; char player; };
+// offsetMs is the time since the game started; thinkMs is how long the
+// player took (for the AI, its search time). -1 when not recorded, e.g.
+// for games saved before timings were kept.
+struct Move {
+    int row;
+    int col;
+    char player;
+    qint64 offsetMs = -1;
+    double thinkMs = -1.0;
+};
 
 // --- GameRecord Struct ---
 struct GameRecord {
+    qint64 id = 0;            // game_history row id, 0 if not stored
     std::string mode;
     std::string winner;
     std::vector<Move> moves;
-    QString timestamp;
+    QString timestamp;        // UTC, DatabaseManager::formatTimestamp
+    double durationMs = 0.0;
+    QString opponent;         // Player 2's name, or "AI"
+};
+
+// --- HistoryFilter Struct ---
+// Criteria for the history queries; empty fields match every game.
+struct HistoryFilter {
+    std::string mode;
+    std::string winner;
+    QString opponent;         // case-insensitive name prefix
+    QDateTime from;           // inclusive; invalid for no lower bound
+    QDateTime to;             // exclusive; invalid for no upper bound
+
+    bool isEmpty() const;
+    bool matches(const GameRecord& record) const;
+    // A mode, result or yyyy-MM-dd date matches that field; any other text
+    // is an opponent prefix.
+    static HistoryFilter fromSearchText(const QString& text);
+};
+
+// --- GameHistoryStore Class ---
+// Copy-on-write game history. snapshot() shares the current records
+// without copying them; the next change made while a snapshot is alive
+// copies the records first, so snapshots never change underneath their
+// holders.
+class GameHistoryStore {
+public:
+    using Snapshot = std::shared_ptr<const std::vector<GameRecord>>;
+
+    GameHistoryStore();
+    GameHistoryStore& operator=(std::vector<GameRecord> history);
+    Snapshot snapshot() const { return records; }
+    // Bumped by every change, so views can tell whether to rebuild.
+    quint64 getRevision() const { return revision; }
+
+    void push_back(const GameRecord& record);
+    void clear();
+    size_t size() const { return records->size(); }
+    bool empty() const { return records->empty(); }
+    const GameRecord& operator[](size_t index) const { return (*records)[index]; }
+    const GameRecord& back() const { return records->back(); }
+    std::vector<GameRecord>::const_iterator begin() const { return records->begin(); }
+    std::vector<GameRecord>::const_iterator end() const { return records->end(); }
+private:
+    std::vector<GameRecord>& detach();
+    std::shared_ptr<std::vector<GameRecord>> records;
+    quint64 revision;
+};
+
+// --- UserStats Struct ---
+// One row of the user_stats table, kept up to date by saveGameRecord.
+// Outcomes are from the signed-in user's side: they play "You" in PvAI
+// and "Player 1" in PvP.
+struct UserStats {
+    int totalGames = 0;
+    int wins = 0;
+    int losses = 0;
+    int draws = 0;
+    int pvpGames = 0;
+    int pvaiGames = 0;
+    int currentStreak = 0;    // +n after n wins in a row, -n after n losses
+    int bestWinStreak = 0;
+    double totalDurationMs = 0.0;
+    QString lastPlayed;
+    double getAverageDurationMs() const { return totalGames ? totalDurationMs / totalGames : 0.0; }
+};
+
+// --- DatabaseProfile Struct ---
+// SQLite pragmas applied when the database is opened. The presets trade
+// durability for fewer fsyncs per write.
+struct DatabaseProfile {
+    QString name;
+    QString journalMode;      // DELETE, TRUNCATE, WAL, MEMORY
+    QString synchronous;      // OFF, NORMAL, FULL
+    QString tempStore;        // DEFAULT, FILE, MEMORY
+    int cacheSizeKB;          // page cache size in KiB
+    qint64 mmapSizeBytes;     // 0 disables memory-mapped I/O
+
+    // Rollback journal and an fsync on every commit (SQLite defaults).
+    static DatabaseProfile durable() {
+        return { "durable", "DELETE", "FULL", "DEFAULT", 2000, 0 };
+    }
+    // WAL only syncs on checkpoint; a power loss can drop the last commits
+    // but never corrupts the database.
+    static DatabaseProfile balanced() {
+        return { "balanced", "WAL", "NORMAL", "MEMORY", 8192, 64LL * 1024 * 1024 };
+    }
+    // No fsyncs at all; an OS crash can corrupt the database.
+    static DatabaseProfile fast() {
+        return { "fast", "WAL", "OFF", "MEMORY", 32768, 256LL * 1024 * 1024 };
+    }
+    static DatabaseProfile fromName(const QString& profileName) {
+        if (profileName == "durable") return durable();
+        if (profileName == "fast") return fast();
+        return balanced();
+    }
+};
+
+// --- DatabaseOperationStats Struct ---
+struct DatabaseOperationStats {
+    PerformanceMonitor latency;
+    quint64 rows = 0;
+    quint64 bytes = 0;        // bound and fetched payload bytes
+    quint64 vmSteps = 0;      // SQLite VM steps, only with TICTACTOE_SQLITE_STATS
+    DatabaseOperationStats(const QString& name = "") : latency(name) {}
+};
+
+// --- DatabaseEngineStats Struct ---
+// Connection-wide SQLite counters, only filled with TICTACTOE_SQLITE_STATS.
+struct DatabaseEngineStats {
+    bool available = false;
+    int cacheHits = 0;
+    int cacheMisses = 0;
+    int cacheUsedBytes = 0;
 };
 
 // --- DatabaseManager Class ---
+// Each thread that calls into a DatabaseManager gets its own named SQLite
+// connection with its own prepared statements. Connections opened by
+// QThreads are released when the thread finishes; other threads should call
+// releaseThreadConnection() before exiting. initializeDatabase() must run
+// once before any other thread uses the manager.
 class DatabaseManager {
+public:
+    // Hot statements prepared once per connection and reused.
+    enum Statement {
+        InsertUserStatement,
+        VerifyUserStatement,
+        UpdatePasswordStatement,
+        InsertGameStatement,
+        LoadHistoryStatement,
+        UpdateUserStatsStatement,
+        LoadUserStatsStatement,
+        SaveGameMetricsStatement,
+        LoadGameMetricsStatement,
+        CountHistoryStatement,
+        LoadHistoryPageStatement,
+        LoadGameMovesStatement,
+        StatementCount
+    };
+    enum HistorySortColumn { SortByTimestamp, SortByMode, SortByWinner, SortByOpponent };
 private:
-    QSqlDatabase db;
+    struct Connection {
+        QString name;
+        QSqlDatabase db;
+        std::vector<QSqlQuery> statements;
+        std::map<QString, QSqlQuery> dynamicStatements;   // keyed by SQL text
+        QMetaObject::Connection threadFinished;
+    };
+
+    QString databaseName;
+    QString connectionPrefix;
+    DatabaseProfile profile;
+    std::atomic<bool> schemaReady;
+    mutable QMutex connectionMutex;
+    std::map<QThread*, std::unique_ptr<Connection>> connections;
+
+    mutable QMutex statsMutex;
     PerformanceMonitor dbPerformanceMonitor;
+    std::vector<DatabaseOperationStats> statementStats;
+    DatabaseOperationStats initializeStats;
 public:
-    DatabaseManager();
+    DatabaseManager(const QString& databaseName = "tictactoe.db",
+                    const DatabaseProfile& databaseProfile = DatabaseProfile::balanced());
     ~DatabaseManager();
+    DatabaseManager(const DatabaseManager&) = delete;
+    DatabaseManager& operator=(const DatabaseManager&) = delete;
     bool initializeDatabase();
+    bool setProfile(const DatabaseProfile& databaseProfile);
+    DatabaseProfile getProfile() const;
+    void releaseThreadConnection();
+    int getConnectionCount() const;
     bool saveUser(const QString& username, const QString& password);
     bool verifyUser(const QString& username, const QString& password);
     bool updateUserPassword(const QString& username, const QString& newPassword);
     bool saveGameRecord(const QString& username, const GameRecord& record);
     std::vector<GameRecord> loadGameHistory(const QString& username);
-    PerformanceMonitor& getPerformanceMonitor() { return dbPerformanceMonitor; }
+    // Keyset pagination: pass the last record of the previous page as
+    // "after". Page rows carry no moves.
+    std::vector<GameRecord> loadGameHistoryPage(const QString& username, const HistoryFilter& filter,
+                                                HistorySortColumn column, Qt::SortOrder order, int limit,
+                                                const GameRecord* after = nullptr);
+    int countGameHistory(const QString& username, const HistoryFilter& filter = HistoryFilter());
+    std::vector<Move> loadGameMoves(qint64 gameId);
+    // The game_history timestamp format, "yyyy-MM-dd HH:mm:ss" in UTC.
+    static QString formatTimestamp(const QDateTime& time);
+    UserStats loadUserStats(const QString& username);
+    // "row-col-player[-offsetMs-thinkMs]" joined by ';'.
+    static QString serializeMoves(const std::vector<Move>& moves);
+    static std::vector<Move> parseMoves(const QString& movesStr);
+    bool saveGameMetrics(const GameMetrics& metrics, const GameContext& context);
+    bool loadGameMetrics(GameMetrics& metrics);
+    PerformanceMonitor getPerformanceMonitor() const;
+    PerformanceMonitor getStatementMonitor(Statement statement) const { return getStatementStats(statement).latency; }
+    DatabaseOperationStats getStatementStats(Statement statement) const;
+    DatabaseOperationStats getInitializeStats() const;
+    DatabaseEngineStats getEngineStats();
+    QString getProfileReport();
 private:
+    Connection* findConnection();
+    Connection* registerConnection(std::unique_ptr<Connection> conn);
+    Connection* threadConnection();
+    std::unique_ptr<Connection> openConnection();
+    void closeConnection(Connection& conn);
+    void releaseConnection(QThread* thread);
+    // A statement run as one step of a larger public call passes
+    // countOperation = false; the call then adds its own recordOperation.
+    void recordStatement(Connection& conn, Statement statement, double elapsed, quint64 rows, quint64 bytes,
+                         QSqlQuery* query = nullptr, bool countOperation = true);
+    void recordOperation(double elapsed);
+    bool commitTransaction(Connection& conn, const char* what);
+    bool applyProfile(QSqlDatabase& db, const DatabaseProfile& databaseProfile);
+    bool createSchema(QSqlDatabase& db);
+    bool prepareStatements(Connection& conn);
+    bool ensureColumn(QSqlDatabase& db, const QString& table, const QString& column, const QString& definition);
+    QSqlQuery* dynamicStatement(Connection& conn, const QString& sql);
+    bool updateUserStats(Connection& conn, const QString& username, const GameRecord& record);
     QString hashPassword(const QString& password, const QString& salt);
     QString generateSalt();
 };
 
+// --- BoardTheme Struct ---
+// Brushes, pens and glyphs for each cell state, built once and looked up
+// by state when a board renders its tiles.
+struct BoardTheme {
+    enum CellState { EmptyCell, XCell, OCell, CellStateCount };
+
+    QBrush background[CellStateCount];
+    QString glyph[CellStateCount];
+    QPen borderPen;
+    QPen glyphPen;
+    QPen focusPen;              // ring around the keyboard cursor's cell
+    QBrush disabledShade;       // laid over every tile while input is off
+    double glyphScale = 0.3;    // glyph pixel size as a fraction of the cell
+
+    static CellState stateFor(char mark) { return mark == 'X' ? XCell : mark == 'O' ? OCell : EmptyCell; }
+    static const BoardTheme& classic();
+};
+
+// --- BoardView Class ---
+// Paints a board of any size in a single widget. Each cell state is a
+// tile pixmap rendered from the theme once per cell size, so a move
+// repaints one cell with one blit; clicks are mapped to cells by
+// coordinates. With focus, the arrow keys move a cell cursor and
+// Space or Enter plays the cell under it.
+class BoardView : public QWidget {
+    Q_OBJECT
+public:
+    static const int MaxCellSize = 80;
+    static const int MinCellSize = 32;
+    static const int MaxBoardExtent = 480;   // cells shrink to keep big boards on screen
+
+    explicit BoardView(int boardSize = 3, QWidget* parent = nullptr);
+    void setBoardSize(int size);
+    int getBoardSize() const { return boardSize; }
+    int getCellSize() const { return cellSize; }
+    // ' ' for an empty cell; setting the mark a cell already has is free.
+    void setCell(int row, int col, char mark);
+    char getCell(int row, int col) const;
+    void clear();
+    // A board that takes no input is drawn shaded.
+    void setInteractive(bool enabled);
+    bool isInteractive() const { return interactive; }
+    void setTheme(const BoardTheme& boardTheme);
+    const BoardTheme& getTheme() const { return theme; }
+    QRect cellRect(int row, int col) const;
+    // (row, col) of the cell under pos, or (-1, -1).
+    QPoint cellAt(const QPoint& pos) const;
+    QPoint getCursorCell() const { return cursorCell; }
+    // ProbeEventBuffer::nowNs() when the latest cellClicked began.
+    qint64 getClickNs() const { return clickNs; }
+signals:
+    void cellClicked(int row, int col);
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
+    void focusInEvent(QFocusEvent* event) override;
+    void focusOutEvent(QFocusEvent* event) override;
+private:
+    const QPixmap& tile(char mark);
+    void moveCursor(int row, int col);
+    void updateAccessibleDescription();
+    int boardSize;
+    int cellSize;
+    std::vector<char> cells;
+    bool interactive;
+    QPoint pressedCell;
+    QPoint cursorCell;   // keyboard cursor, always on the board
+    qint64 clickNs;
+    BoardTheme theme;
+    QPixmap tiles[BoardTheme::CellStateCount];
+    qreal tileRatio;     // device pixel ratio the tiles were rendered for, 0 if stale
+};
+
 // --- GameBoard Class ---
 class GameBoard : public QWidget {
     Q_OBJECT
 public:
     GameBoard(QWidget *parent = nullptr, int mode = 0);
     ~GameBoard();
-    void initializeBoard();
     void resetBoard();
+    // Starts a new game in the given mode, reusing this widget.
+    void configure(int mode);
+    int getGameMode() const { return gameMode; }
     bool makeMove(int row, int col, char player);
     bool checkWinner(char player);
     bool isFull();
@@ -173,26 +870,72 @@ public:
     void disableBoard();
     void enableBoard();
     PerformanceMonitor& getAiPerformanceMonitor() { return aiPerformanceMonitor; }
+    const Move& getLastMove() const { return lastMove; }
 public slots:
-    void onCellClicked();
+    void onCellClicked(int row, int col);
     void aiMove();
     void triggerAiMove();
 signals:
     void gameOver(const QString& winner);
     void moveMade(int row, int col, char player);
 private:
+    // Builds the BoardView once, from the constructor.
+    void initializeBoard();
+
     std::vector<std::vector<char>> board;
-    std::vector<std::vector<QPushButton*>> buttons;
+    BoardView* boardView;
     QGridLayout* mainLayout;
+    QTimer* aiTimer;
     char currentPlayer;
     bool gameActive;
     int gameMode;
     PerformanceMonitor aiPerformanceMonitor;
+    QElapsedTimer moveClock;            // restarted with each game
+    qint64 lastMoveOffsetMs = 0;
+    double lastAiThinkMs = 0.0;
+    Move lastMove = { -1, -1, ' ' };
+    QPoint pendingPaintCell = QPoint(-1, -1);
+    qint64 pendingPaintClickNs = 0;
+    bool eventFilter(QObject* watched, QEvent* event) override;
     QPoint findBestMove();
     int minimax(std::vector<std::vector<char>> currentBoard, char player);
     std::vector<QPoint> getAvailableMoves(const std::vector<std::vector<char>>& b);
 };
 
+// --- GamePersister Class ---
+// Saves finished games and appends metrics snapshots on a worker thread,
+// one job at a time in submission order, so the dialog is ready for the
+// next game as soon as the last one ends. The worker keeps its own
+// database connection; jobs still queued are finished on destruction.
+class GamePersister : public QObject {
+    Q_OBJECT
+public:
+    struct Job {
+        DatabaseManager* database = nullptr;
+        QString username;               // empty: the record is not saved
+        GameRecord record;
+        bool saveMetrics = false;
+        GameMetrics metrics;
+        GameContext context;
+        MetricsExporter* exporter = nullptr;
+        std::vector<PerformanceMonitor> monitors;
+    };
+
+    explicit GamePersister(QObject* parent = nullptr);
+    ~GamePersister();
+    void submit(const Job& job);
+    int pendingCount() const { return pending; }
+signals:
+    void saved(bool ok);
+private:
+    void run(const Job& job);
+    QThread thread;
+    QObject* worker;            // lives in thread; jobs are queued to it
+    std::atomic<int> pending;
+};
+
+class ReplayListModel;
+
 // --- GameDialog Class ---
 class GameDialog : public QDialog {
     Q_OBJECT
@@ -205,10 +948,15 @@ public slots:
     void on_pvaiButton_clicked();
     void on_replayButton_clicked();
     void onComboBoxActivated(int index);
+    void onReplaySearchChanged();
     void onGameOver(const QString& winner);
+    void onGameSaved(bool ok);
+    void on_detailsButton_clicked();
     void recordMove(int row, int col, char player);
 private:
     void startGame(int mode);
+    void refreshReplayList();
+    QString performanceReport() const;
     QGridLayout* mainLayout;
     QVBoxLayout* verticalLayout;
     QHBoxLayout* buttonLayout;
@@ -216,10 +964,83 @@ private:
     QPushButton* pvaiButton;
     QPushButton* replayButton;
     QComboBox* comboBoxGameList;
+    QLineEdit* replaySearchEdit;
+    QTimer* replaySearchTimer;
+    ReplayListModel* replayListModel;
+    quint64 replayRevision;   // gameHistory revision the list was built from
+    QString replayUser;       // user whose database history is listed, if any
+    QFrame* resultsPanel;     // last game's result, hidden by the next move
+    QLabel* resultsLabel;
+    QPushButton* detailsButton;
+    GamePersister* persister;
     QString player1Name;
     QString player2Name;
     int gameMode;
     std::vector<Move> moves;
+    QElapsedTimer gameClock;
+};
+
+// --- GameHistoryModel Class ---
+// Table model over a user's game history. With a database source, rows
+// are fetched a page at a time as the view scrolls and sorting re-queries
+// the database; otherwise it pages over an in-memory copy of the records.
+class GameHistoryModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    enum Column { ModeColumn, OpponentColumn, WinnerColumn, PlayedColumn, ColumnCount };
+    static const int PageSize = 200;
+
+    explicit GameHistoryModel(QObject* parent = nullptr);
+    void setDatabaseSource(DatabaseManager* manager, const QString& username);
+    void setRecords(const GameHistoryStore::Snapshot& history);
+    void setFilter(const HistoryFilter& historyFilter);
+    const HistoryFilter& getFilter() const { return filter; }
+    int totalRowCount() const { return totalRows; }
+    const GameRecord& recordAt(int row) const { return database ? rows[row] : (*records)[order[row]]; }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+private:
+    void reload();
+    DatabaseManager* database;
+    QString username;
+    HistoryFilter filter;
+    std::vector<GameRecord> rows;         // database source: the rows fetched so far
+    GameHistoryStore::Snapshot records;   // in-memory source, in played order
+    // In-memory source: indexes of the records passing the filter, sorted,
+    // of which the first loadedRows are exposed.
+    std::vector<int> order;
+    int loadedRows;
+    int totalRows;
+    Column sortColumn;
+    Qt::SortOrder sortOrder;
+};
+
+// --- ReplayListModel Class ---
+// Items for the replay picker: a "Select a game..." placeholder followed
+// by the games of a GameHistoryModel, which pages them in as the list
+// scrolls.
+class ReplayListModel : public QAbstractListModel {
+    Q_OBJECT
+public:
+    explicit ReplayListModel(QObject* parent = nullptr);
+    GameHistoryModel* getSource() const { return source; }
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+private slots:
+    void onSourceAboutToBeReset();
+    void onSourceReset();
+    void onSourceRowsAboutToBeInserted(const QModelIndex& parent, int first, int last);
+    void onSourceRowsInserted();
+private:
+    GameHistoryModel* source;
 };
 
 // --- HistoryDialog Class ---
@@ -228,34 +1049,106 @@ class HistoryDialog : public QDialog {
 public:
     HistoryDialog(QWidget *parent = nullptr);
     ~HistoryDialog();
-    void setGameHistory(const std::vector<GameRecord>& history);
+    void setGameHistory(const GameHistoryStore::Snapshot& history);
+    void setDatabaseSource(DatabaseManager* manager, const QString& username);
+protected:
+    void hideEvent(QHideEvent* event) override;
 private slots:
     void on_closeButton_clicked();
+    void applyFilter();
 private:
-    void displayGameHistory();
+    void updateTitle();
     QVBoxLayout* mainLayout;
+    QHBoxLayout* filterLayout;
+    QComboBox* modeFilter;
+    QComboBox* winnerFilter;
+    QComboBox* periodFilter;
+    QLineEdit* opponentFilter;
+    QTimer* filterTimer;
     QPushButton* closeButton;
-    std::vector<GameRecord> gameHistory;
-    QTextEdit* historyTextEdit;
+    GameHistoryModel* historyModel;
+    QTableView* historyView;
     QLabel* titleLabel;
 };
 
+// --- ReplayEngine Class ---
+// Steps through a recorded game. The board after every ply is computed
+// once up front as an X bitset and an O bitset, so seeking anywhere is
+// O(1). All plies share one flat array at two bits per cell per ply.
+class ReplayEngine {
+public:
+    static const int MaxBoardSize = 32;    // moves beyond this are treated as corrupt
+    static const int BaseIntervalMs = 500; // one ply per interval at 1x speed
+
+    ReplayEngine();
+    ReplayEngine(const std::vector<Move>& moves, int boardSize = 3);
+    void load(const std::vector<Move>& moves, int boardSize = 3);
+    // The smallest board, at least 3x3, that holds every move.
+    static int boardSizeFor(const std::vector<Move>& moves);
+
+    int getBoardSize() const { return boardSize; }
+    int getPlyCount() const { return static_cast<int>(cells.size() / (2 * wordsPerSide)) - 1; }
+    int getPly() const { return ply; }
+    bool atEnd() const { return ply == getPlyCount(); }
+    bool seek(int targetPly);
+    bool stepForward() { return seek(ply + 1); }
+    bool stepBack() { return seek(ply - 1); }
+
+    // The board at the current ply; ' ' for an empty cell.
+    char cellAt(int row, int col) const;
+    // The bitset words of a ply: X cells, then O cells from
+    // getWordsPerSide() on; bit row * boardSize + col.
+    const quint64* getSnapshot(int atPly) const { return &cells[size_t(atPly) * 2 * wordsPerSide]; }
+    int getWordsPerSide() const { return wordsPerSide; }
+    // The move that led to the current ply, or nullptr at the start.
+    const Move* getLastMove() const { return ply > 0 ? &moves[ply - 1] : nullptr; }
+
+    // Playback speed as a multiple of 1x, clamped to [0.25, 16].
+    void setSpeed(double multiplier);
+    double getSpeed() const { return speed; }
+    int getIntervalMs() const;
+private:
+    std::vector<Move> moves;
+    std::vector<quint64> cells;   // ply i is the board after i moves
+    int boardSize;
+    int wordsPerSide;             // words per bitset, (boardSize^2 + 63) / 64
+    int ply;
+    double speed;
+};
+
 // --- ReplayDialog Class ---
 class ReplayDialog : public QDialog {
     Q_OBJECT
 public:
     ReplayDialog(const std::vector<Move>& moves, QWidget* parent = nullptr);
     ~ReplayDialog();
+    const ReplayEngine& getEngine() const { return engine; }
 private slots:
     void playNextMove();
     void on_closeButton_clicked();
+    void on_startButton_clicked();
+    void on_backButton_clicked();
+    void on_playButton_clicked();
+    void on_forwardButton_clicked();
+    void on_endButton_clicked();
+    void on_speedComboBox_activated(int index);
+    void seekTo(int ply);
 private:
-    void initializeBoard();
+    void renderBoard();
+    void setPlaying(bool playing);
     QGridLayout* boardLayout;
-    std::vector<QLabel*> cellLabels;
+    QHBoxLayout* controlLayout;
+    BoardView* boardView;
     QTimer* timer;
-    std::vector<Move> movesToReplay;
-    int moveIndex;
+    ReplayEngine engine;
+    QPushButton* startButton;
+    QPushButton* backButton;
+    QPushButton* playButton;
+    QPushButton* forwardButton;
+    QPushButton* endButton;
+    QComboBox* speedComboBox;
+    QSlider* positionSlider;
+    QLabel* positionLabel;
     QPushButton* closeButton;
 };
 
@@ -265,12 +1158,20 @@ class MainWindow : public QMainWindow {
 public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
-    static std::vector<GameRecord> gameHistory;
+    // Games played this session. With a database the history views page
+    // from it instead, so earlier games are never loaded here.
+    static GameHistoryStore gameHistory;
     static QString currentUser;
     static DatabaseManager* dbManager;
     static GameMetrics gameMetrics;
     static PerformanceMonitor loginPerformanceMonitor;
-    static void saveGameHistory();
+    static PerformanceMonitor aiPerformanceMonitor;
+    static PerformanceMonitor thinkTimeMonitor;
+    static PerformanceMonitor inputLatencyMonitor;
+    static PerformanceMonitor clickToMoveMonitor;
+    static MetricsExporter* metricsExporter;
+    static std::vector<PerformanceMonitor> snapshotMonitors();
+    static void exportMetricsSnapshot();
 private slots:
     void signInButtonClicked();
     void signUpButtonClicked();
@@ -280,7 +1181,9 @@ private:
     Ui::MainWindow *ui;
     GameDialog* gameDialog;
     HistoryDialog* historyDialog;
-    static void loadGameHistory();
+    MetricsServer* metricsServer;
+    static void beginHistorySession();
+    void startMetricsServer(quint16 port);
 };
 
 #endif // MAINWINDOW_H
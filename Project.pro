@@ -1,5 +1,5 @@
 
-QT += core widgets sql
+QT += core widgets sql network
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 CONFIG += c++17
@@ -8,6 +8,19 @@ CONFIG += c++17
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 INCLUDEPATH += Include
+
+# Heap accounting per subsystem: qmake CONFIG+=alloc_tracking
+alloc_tracking: DEFINES += TICTACTOE_ALLOC_TRACKING
+
+# SQLite engine counters (page cache hits, VM steps): qmake CONFIG+=sqlite_stats
+# They call sqlite3 on the QSQLITE driver's native handles, so they are only
+# valid when Qt was configured with -system-sqlite and the plugin uses the
+# same libsqlite3 this links; official Qt builds bundle their own copy.
+sqlite_stats {
+    CONFIG += link_pkgconfig
+    PKGCONFIG += sqlite3
+    DEFINES += TICTACTOE_SQLITE_STATS
+}
 SOURCES += \
     Src/main.cpp \
     Src/mainwindow.cpp
@@ -5,11 +5,81 @@
 #include <QInputDialog>
 #include <QStackedWidget>
 #include <QScrollBar>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QKeyEvent>
+#include <QFocusEvent>
 #include <QSqlRecord>
+#include <QSqlDriver>
+#include <QSqlResult>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSysInfo>
+#include <QUuid>
+#include <cstring>
+#include <cstdlib>
+#include <new>
+#include <cstdint>
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#ifdef TICTACTOE_SQLITE_STATS
+#include <sqlite3.h>
+#endif
 #ifdef _WIN32
 ULONGLONG PerformanceMonitor::lastIdleTime = 0;
 ULONGLONG PerformanceMonitor::lastKernelTime = 0;
 ULONGLONG PerformanceMonitor::lastUserTime = 0;
+#elif defined(__linux__)
+quint64 PerformanceMonitor::lastSystemTotalTicks = 0;
+quint64 PerformanceMonitor::lastSystemIdleTicks = 0;
+quint64 PerformanceMonitor::lastProcessTicks = 0;
+qint64 PerformanceMonitor::lastProcessSampleNs = 0;
+
+// /proc files are tiny; one read() into a stack buffer avoids iostreams
+// and heap allocations so sampling stays cheap.
+static bool readProcFile(const char* path, char* buffer, size_t size)
+{
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+    ssize_t length = ::read(fd, buffer, size - 1);
+    ::close(fd);
+    if (length <= 0)
+        return false;
+    buffer[length] = '\0';
+    return true;
+}
+
+// Value of a "Key:   123 kB" line from /proc/self/status.
+static quint64 procStatusField(const char* status, const char* key)
+{
+    const char* line = std::strstr(status, key);
+    return line ? std::strtoull(line + std::strlen(key), nullptr, 10) : 0;
+}
+
+// Sums the aggregate "cpu" line of /proc/stat; idle includes iowait.
+static bool readSystemCpuTicks(quint64& total, quint64& idle)
+{
+    char buffer[512];
+    if (!readProcFile("/proc/stat", buffer, sizeof(buffer)) || std::strncmp(buffer, "cpu ", 4) != 0)
+        return false;
+
+    char* cursor = buffer + 4;
+    quint64 fields[8] = {};
+    for (quint64& field : fields)
+        field = std::strtoull(cursor, &cursor, 10);
+
+    total = 0;
+    for (quint64 field : fields)
+        total += field;
+    idle = fields[3] + fields[4];
+    return true;
+}
 #endif
 
 double PerformanceMonitor::getCurrentMemoryUsageMB() {
@@ -18,6 +88,11 @@ double PerformanceMonitor::getCurrentMemoryUsageMB() {
     if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
         return pmc.WorkingSetSize / (1024.0 * 1024.0); // MB
     }
+#elif defined(__linux__)
+    char status[4096];
+    if (readProcFile("/proc/self/status", status, sizeof(status))) {
+        return procStatusField(status, "VmRSS:") / 1024.0; // kB -> MB
+    }
 #endif
     return 0.0;
 }
@@ -32,86 +107,1588 @@ double PerformanceMonitor::getCPUUsagePercent() {
     ULONGLONG kernel = ((ULONGLONG)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
     ULONGLONG user = ((ULONGLONG)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
 
-    ULONGLONG sys = (kernel - lastKernelTime) + (user - lastUserTime);
-    ULONGLONG idleDiff = idle - lastIdleTime;
+    ULONGLONG sys = (kernel - lastKernelTime) + (user - lastUserTime);
+    ULONGLONG idleDiff = idle - lastIdleTime;
+
+    double cpuUsage = 0.0;
+    if (sys != 0) {
+        cpuUsage = (1.0 - ((double)idleDiff / sys)) * 100.0;
+    }
+
+    lastIdleTime = idle;
+    lastKernelTime = kernel;
+    lastUserTime = user;
+
+    return cpuUsage;
+#elif defined(__linux__)
+    quint64 total = 0, idle = 0;
+    if (!readSystemCpuTicks(total, idle))
+        return 0.0;
+
+    quint64 totalDiff = total - lastSystemTotalTicks;
+    quint64 idleDiff = idle - lastSystemIdleTicks;
+
+    double cpuUsage = 0.0;
+    if (totalDiff != 0) {
+        cpuUsage = (1.0 - ((double)idleDiff / totalDiff)) * 100.0;
+    }
+
+    lastSystemTotalTicks = total;
+    lastSystemIdleTicks = idle;
+
+    return cpuUsage;
+#else
+    return 0.0;
+#endif
+}
+
+ResourceUsage PerformanceMonitor::sampleResourceUsage() {
+    ResourceUsage usage;
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        usage.rssMB = pmc.WorkingSetSize / (1024.0 * 1024.0);
+        usage.peakRssMB = pmc.PeakWorkingSetSize / (1024.0 * 1024.0);
+        usage.minorPageFaults = pmc.PageFaultCount;
+    }
+    usage.systemCpuPercent = getCPUUsagePercent();
+#elif defined(__linux__)
+    char status[4096];
+    if (readProcFile("/proc/self/status", status, sizeof(status))) {
+        usage.rssMB = procStatusField(status, "VmRSS:") / 1024.0;
+        usage.peakRssMB = procStatusField(status, "VmHWM:") / 1024.0;
+        usage.voluntaryContextSwitches = procStatusField(status, "\nvoluntary_ctxt_switches:");
+        usage.involuntaryContextSwitches = procStatusField(status, "nonvoluntary_ctxt_switches:");
+    }
+
+    // Fields after the parenthesised command name start at field 3 (state);
+    // minflt is field 10, majflt 12, utime 14 and stime 15.
+    char stat[1024];
+    const char* fields = readProcFile("/proc/self/stat", stat, sizeof(stat)) ? std::strrchr(stat, ')') : nullptr;
+    if (fields) {
+        char* cursor = const_cast<char*>(fields) + 2;
+        quint64 values[13] = {};
+        for (int field = 3; field <= 15; ++field) {
+            while (*cursor == ' ')
+                ++cursor;
+            values[field - 3] = (field == 3) ? 0 : std::strtoull(cursor, nullptr, 10);
+            while (*cursor && *cursor != ' ')
+                ++cursor;
+        }
+        usage.minorPageFaults = values[10 - 3];
+        usage.majorPageFaults = values[12 - 3];
+
+        quint64 processTicks = values[14 - 3] + values[15 - 3];
+        qint64 nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch()).count();
+        if (lastProcessSampleNs != 0 && nowNs > lastProcessSampleNs) {
+            double cpuSeconds = double(processTicks - lastProcessTicks) / ::sysconf(_SC_CLK_TCK);
+            double wallSeconds = (nowNs - lastProcessSampleNs) / 1e9;
+            usage.processCpuPercent = cpuSeconds / wallSeconds * 100.0;
+        }
+        lastProcessTicks = processTicks;
+        lastProcessSampleNs = nowNs;
+    }
+
+    usage.systemCpuPercent = getCPUUsagePercent();
+#endif
+    return usage;
+}
+
+// ------------------------------------------------------------------
+// Allocation tracking
+
+#ifdef TICTACTOE_ALLOC_TRACKING_ACTIVE
+namespace {
+struct AllocationCounters {
+    std::atomic<quint64> liveBytes;
+    std::atomic<quint64> peakBytes;
+    std::atomic<quint64> allocations;
+    std::atomic<quint64> deallocations;
+    std::atomic<quint64> totalBytes;
+};
+
+// Zero-initialized before any dynamic initialization runs, so allocations
+// made by static constructors are counted too.
+AllocationCounters allocationCounters[AllocationTracker::SubsystemCount];
+thread_local int currentAllocationSubsystem = AllocationTracker::Untagged;
+
+// 16 bytes keeps the returned block aligned like malloc's.
+struct AllocationHeader {
+    std::size_t size;
+    std::uint32_t subsystem;
+    std::uint32_t magic;
+};
+static_assert(sizeof(AllocationHeader) == 16, "allocation header must preserve alignment");
+const std::uint32_t AllocationMagic = 0xA110CA7E;
+
+void* trackedAllocate(std::size_t size)
+{
+    AllocationHeader* header = static_cast<AllocationHeader*>(std::malloc(sizeof(AllocationHeader) + size));
+    if (!header)
+        return nullptr;
+    int subsystem = currentAllocationSubsystem;
+    header->size = size;
+    header->subsystem = static_cast<std::uint32_t>(subsystem);
+    header->magic = AllocationMagic;
+
+    AllocationCounters& counters = allocationCounters[subsystem];
+    quint64 live = counters.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    quint64 peak = counters.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.totalBytes.fetch_add(size, std::memory_order_relaxed);
+    return header + 1;
+}
+
+void trackedFree(void* pointer)
+{
+    if (!pointer)
+        return;
+    AllocationHeader* header = static_cast<AllocationHeader*>(pointer) - 1;
+    Q_ASSERT(header->magic == AllocationMagic);
+    AllocationCounters& counters = allocationCounters[header->subsystem];
+    counters.liveBytes.fetch_sub(header->size, std::memory_order_relaxed);
+    counters.deallocations.fetch_add(1, std::memory_order_relaxed);
+    header->magic = 0;
+    std::free(header);
+}
+}
+
+void* operator new(std::size_t size)
+{
+    if (void* pointer = trackedAllocate(size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (void* pointer = trackedAllocate(size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return trackedAllocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return trackedAllocate(size); }
+void operator delete(void* pointer) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+
+bool AllocationTracker::isEnabled() { return true; }
+
+AllocationStats AllocationTracker::getStats(Subsystem subsystem)
+{
+    const AllocationCounters& counters = allocationCounters[subsystem];
+    AllocationStats stats;
+    stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+    stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+    stats.deallocations = counters.deallocations.load(std::memory_order_relaxed);
+    stats.totalBytes = counters.totalBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+AllocationTracker::Subsystem AllocationTracker::exchangeCurrent(Subsystem subsystem)
+{
+    Subsystem previous = static_cast<Subsystem>(currentAllocationSubsystem);
+    currentAllocationSubsystem = subsystem;
+    return previous;
+}
+#else
+bool AllocationTracker::isEnabled() { return false; }
+AllocationStats AllocationTracker::getStats(Subsystem) { return AllocationStats(); }
+AllocationTracker::Subsystem AllocationTracker::exchangeCurrent(Subsystem) { return Untagged; }
+#endif
+
+const char* AllocationTracker::subsystemName(Subsystem subsystem)
+{
+    static const char* const names[SubsystemCount] = {
+        "Untagged", "Game History", "Monitoring", "Widgets", "AI Search", "Database"
+    };
+    return subsystem >= 0 && subsystem < SubsystemCount ? names[subsystem] : "Unknown";
+}
+
+QString PerformanceMonitor::getAllocationReport()
+{
+    if (!AllocationTracker::isEnabled())
+        return QString();
+
+    QStringList lines;
+    for (int s = 0; s < AllocationTracker::SubsystemCount; ++s) {
+        AllocationTracker::Subsystem subsystem = static_cast<AllocationTracker::Subsystem>(s);
+        AllocationStats stats = AllocationTracker::getStats(subsystem);
+        lines << QString("%1: live %2 KB, peak %3 KB, %4 allocations")
+                     .arg(AllocationTracker::subsystemName(subsystem))
+                     .arg(stats.liveBytes / 1024.0, 0, 'f', 1)
+                     .arg(stats.peakBytes / 1024.0, 0, 'f', 1)
+                     .arg(stats.allocations);
+    }
+    return lines.join('\n');
+}
+
+// ------------------------------------------------------------------
+// LatencyHistogram Implementation
+
+std::vector<quint64> LatencyHistogram::newCounts()
+{
+    AllocationScope scope(AllocationTracker::Monitoring);
+    return std::vector<quint64>(BucketCount, 0);
+}
+
+double LatencyHistogram::getPercentile(double percentile) const
+{
+    if (totalCount == 0)
+        return 0.0;
+
+    quint64 rank = static_cast<quint64>(std::ceil(percentile / 100.0 * totalCount));
+    rank = std::min(std::max<quint64>(rank, 1), totalCount);
+    // The extremes are tracked exactly.
+    if (rank == 1)
+        return minValue;
+    if (rank == totalCount)
+        return maxValue;
+
+    quint64 seen = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            double midpointMs = (bucketLowerBound(i) + bucketUpperBound(i)) / 2000.0;
+            return std::min(std::max(midpointMs, minValue), maxValue);
+        }
+    }
+    return maxValue;
+}
+
+// The bucket that straddles ms is left out, so the result may undercount
+// by up to one bucket (~3%) but never counts a sample above ms.
+quint64 LatencyHistogram::countAtOrBelow(double ms) const
+{
+    if (ms >= maxValue)
+        return totalCount;
+    quint64 us = ms > 0.0 ? static_cast<quint64>(ms * 1000.0) : 0;
+    int last = bucketIndex(us);
+    if (bucketUpperBound(last) > us)
+        --last;
+    quint64 count = 0;
+    for (int i = 0; i <= last; ++i)
+        count += counts[i];
+    return count;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    if (other.totalCount == 0)
+        return;
+    for (int i = 0; i < BucketCount; ++i)
+        counts[i] += other.counts[i];
+    if (totalCount == 0 || other.minValue < minValue) minValue = other.minValue;
+    if (totalCount == 0 || other.maxValue > maxValue) maxValue = other.maxValue;
+    totalCount += other.totalCount;
+    sum += other.sum;
+}
+
+void LatencyHistogram::reset()
+{
+    std::fill(counts.begin(), counts.end(), 0);
+    totalCount = 0;
+    sum = 0.0;
+    minValue = 0.0;
+    maxValue = 0.0;
+}
+
+// ------------------------------------------------------------------
+// PerformanceMonitor rolling window
+
+static qint64 monotonicMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void PerformanceMonitor::setRollingWindow(qint64 windowMs, int sliceCount)
+{
+    if (windowMs <= 0 || sliceCount <= 0) {
+        windowSlices.clear();
+        windowSliceEpochs.clear();
+        windowSliceMs = 0;
+        return;
+    }
+    windowSliceMs = std::max<qint64>(1, windowMs / sliceCount);
+    windowSlices.assign(static_cast<size_t>(sliceCount), LatencyHistogram());
+    windowSliceEpochs.assign(static_cast<size_t>(sliceCount), -1);
+}
+
+void PerformanceMonitor::recordInWindow(double elapsed)
+{
+    qint64 epoch = monotonicMs() / windowSliceMs;
+    size_t slot = static_cast<size_t>(epoch % static_cast<qint64>(windowSlices.size()));
+    if (windowSliceEpochs[slot] != epoch) {
+        windowSlices[slot].reset();
+        windowSliceEpochs[slot] = epoch;
+    }
+    windowSlices[slot].record(elapsed);
+}
+
+LatencyHistogram PerformanceMonitor::getWindowHistogram() const
+{
+    LatencyHistogram merged;
+    if (windowSliceMs <= 0)
+        return merged;
+
+    qint64 currentEpoch = monotonicMs() / windowSliceMs;
+    qint64 oldestEpoch = currentEpoch - static_cast<qint64>(windowSlices.size()) + 1;
+    for (size_t i = 0; i < windowSlices.size(); ++i) {
+        if (windowSliceEpochs[i] >= oldestEpoch)
+            merged.merge(windowSlices[i]);
+    }
+    return merged;
+}
+
+// ------------------------------------------------------------------
+// Probe event buffers
+
+namespace {
+QMutex probeRegistryMutex;
+std::vector<std::shared_ptr<ProbeEventBuffer>> probeRegistry;
+quint64 droppedProbeEvents = 0;
+int nextProbeThreadIndex = 0;
+}
+
+// Owned by a thread_local; keeps the buffer registered after the thread
+// exits so its last events can still be drained.
+struct ProbeThreadRegistration {
+    std::shared_ptr<ProbeEventBuffer> buffer;
+    ProbeThreadRegistration() {
+        AllocationScope allocations(AllocationTracker::Monitoring);
+        QMutexLocker locker(&probeRegistryMutex);
+        buffer = std::make_shared<ProbeEventBuffer>(nextProbeThreadIndex++);
+        probeRegistry.push_back(buffer);
+    }
+    ~ProbeThreadRegistration() { buffer->threadExited = true; }
+};
+
+ProbeEventBuffer& ProbeEventBuffer::local()
+{
+    thread_local ProbeThreadRegistration registration;
+    return *registration.buffer;
+}
+
+std::vector<ProbeEvent> ProbeEventBuffer::drainAll()
+{
+    QMutexLocker locker(&probeRegistryMutex);
+    std::vector<ProbeEvent> drained;
+
+    for (auto it = probeRegistry.begin(); it != probeRegistry.end();) {
+        ProbeEventBuffer& buffer = **it;
+        quint64 end = buffer.head.load(std::memory_order_acquire);
+        // The slot after the newest event may already be half-written, so at
+        // most Capacity - 1 events are readable.
+        quint64 begin = std::max(buffer.tail, end >= Capacity ? end - Capacity + 1 : 0);
+
+        size_t first = drained.size();
+        for (quint64 position = begin; position < end; ++position)
+            drained.push_back(buffer.events[position & (Capacity - 1)]);
+
+        // Slots the writer reused while we copied, including the one it may
+        // be writing right now, can be torn; drop them.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        quint64 after = buffer.head.load(std::memory_order_relaxed);
+        quint64 safeBegin = after + 1 > Capacity ? after + 1 - Capacity : 0;
+        quint64 torn = safeBegin > begin ? std::min(safeBegin, end) - begin : 0;
+        drained.erase(drained.begin() + first, drained.begin() + first + static_cast<size_t>(torn));
+
+        droppedProbeEvents += (begin - buffer.tail) + torn;
+        buffer.tail = end;
+
+        if (buffer.threadExited && buffer.head.load(std::memory_order_acquire) == buffer.tail)
+            it = probeRegistry.erase(it);
+        else
+            ++it;
+    }
+    return drained;
+}
+
+quint64 ProbeEventBuffer::getDroppedEventCount()
+{
+    QMutexLocker locker(&probeRegistryMutex);
+    return droppedProbeEvents;
+}
+
+std::map<QString, LatencyHistogram> PerformanceMonitor::aggregateProbeEvents(const std::vector<ProbeEvent>& events)
+{
+    std::map<QString, LatencyHistogram> byName;
+    for (const ProbeEvent& event : events)
+        byName[QString::fromLatin1(event.name)].record(event.durationNs / 1000000.0);
+    return byName;
+}
+
+QString PerformanceMonitor::getSummary() const
+{
+    return QString("%1: n=%2 avg=%3 p50=%4 p99=%5 max=%6 ms")
+        .arg(operationName)
+        .arg(histogram.getCount())
+        .arg(getAverageTime(), 0, 'f', 3)
+        .arg(getPercentile(50), 0, 'f', 3)
+        .arg(getPercentile(99), 0, 'f', 3)
+        .arg(getMaxTime(), 0, 'f', 3);
+}
+
+// ------------------------------------------------------------------
+// TraceRecorder Implementation
+
+namespace {
+QMutex traceMutex;
+QString traceOutputFile;
+std::vector<ProbeEvent> traceEvents;
+}
+
+void TraceRecorder::setOutputFile(const QString& path)
+{
+    QMutexLocker locker(&traceMutex);
+    traceOutputFile = path;
+    traceEvents.clear();
+}
+
+QString TraceRecorder::getOutputFile()
+{
+    QMutexLocker locker(&traceMutex);
+    return traceOutputFile;
+}
+
+bool TraceRecorder::isEnabled()
+{
+    QMutexLocker locker(&traceMutex);
+    return !traceOutputFile.isEmpty();
+}
+
+void TraceRecorder::collect()
+{
+    if (!isEnabled())
+        return;
+    AllocationScope allocations(AllocationTracker::Monitoring);
+    std::vector<ProbeEvent> drained = ProbeEventBuffer::drainAll();
+    QMutexLocker locker(&traceMutex);
+    if (!traceOutputFile.isEmpty())
+        traceEvents.insert(traceEvents.end(), drained.begin(), drained.end());
+}
+
+size_t TraceRecorder::getEventCount()
+{
+    QMutexLocker locker(&traceMutex);
+    return traceEvents.size();
+}
+
+bool TraceRecorder::flush()
+{
+    if (!isEnabled())
+        return false;
+    collect();
+
+    QString path;
+    std::vector<ProbeEvent> events;
+    {
+        QMutexLocker locker(&traceMutex);
+        path = traceOutputFile;
+        events = traceEvents;
+    }
+    return writeChromeTrace(path, events);
+}
+
+// Complete ("X") events with timestamps in microseconds from the first
+// event, plus metadata naming the process and each probe thread.
+QByteArray TraceRecorder::toChromeTrace(const std::vector<ProbeEvent>& events)
+{
+    qint64 originNs = 0;
+    if (!events.empty()) {
+        originNs = std::min_element(events.begin(), events.end(),
+                                    [](const ProbeEvent& a, const ProbeEvent& b) {
+                                        return a.startNs < b.startNs;
+                                    })->startNs;
+    }
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    QJsonArray traceEventArray;
+    QJsonObject processName;
+    processName["name"] = "process_name";
+    processName["ph"] = "M";
+    processName["pid"] = pid;
+    processName["args"] = QJsonObject{{"name", "TicTacToe"}};
+    traceEventArray.append(processName);
+
+    std::vector<int> namedThreads;
+    for (const ProbeEvent& event : events) {
+        if (std::find(namedThreads.begin(), namedThreads.end(), event.threadIndex) == namedThreads.end()) {
+            namedThreads.push_back(event.threadIndex);
+            QJsonObject threadName;
+            threadName["name"] = "thread_name";
+            threadName["ph"] = "M";
+            threadName["pid"] = pid;
+            threadName["tid"] = event.threadIndex;
+            threadName["args"] = QJsonObject{{"name", QString("Thread %1").arg(event.threadIndex)}};
+            traceEventArray.append(threadName);
+        }
+
+        // "ai.findBestMove" is shown in category "ai".
+        QString name = QString::fromLatin1(event.name);
+        QJsonObject entry;
+        entry["name"] = name;
+        entry["cat"] = name.section('.', 0, 0);
+        entry["ph"] = "X";
+        entry["ts"] = (event.startNs - originNs) / 1000.0;
+        entry["dur"] = event.durationNs / 1000.0;
+        entry["pid"] = pid;
+        entry["tid"] = event.threadIndex;
+        traceEventArray.append(entry);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEventArray;
+    root["displayTimeUnit"] = "ms";
+    root["otherData"] = QJsonObject{
+        {"droppedEvents", static_cast<double>(ProbeEventBuffer::getDroppedEventCount())}
+    };
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+bool TraceRecorder::writeChromeTrace(const QString& path, const std::vector<ProbeEvent>& events)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Error opening trace file:" << file.errorString();
+        return false;
+    }
+    file.write(toChromeTrace(events));
+    if (!file.commit()) {
+        qDebug() << "Error writing trace file:" << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------
+// MetricsServer Implementation
+
+MetricsServer::MetricsServer(QObject* parent)
+    : QObject(parent), server(new QTcpServer(this))
+{
+    connect(server, &QTcpServer::newConnection, this, &MetricsServer::onNewConnection);
+}
+
+MetricsServer::~MetricsServer()
+{
+    stop();
+}
+
+bool MetricsServer::start(quint16 port)
+{
+    if (server->isListening())
+        return true;
+    if (!server->listen(QHostAddress::LocalHost, port)) {
+        qDebug() << "Error starting metrics server:" << server->errorString();
+        return false;
+    }
+    return true;
+}
+
+void MetricsServer::stop()
+{
+    server->close();
+}
+
+bool MetricsServer::isListening() const
+{
+    return server->isListening();
+}
+
+quint16 MetricsServer::serverPort() const
+{
+    return server->serverPort();
+}
+
+void MetricsServer::addCounter(const QString& name, const QString& help, std::function<double()> value,
+                               const QString& labels)
+{
+    Metric metric;
+    metric.name = name;
+    metric.help = help;
+    metric.labels = labels;
+    metric.counter = std::move(value);
+    metrics.push_back(std::move(metric));
+}
+
+void MetricsServer::addGauge(const QString& name, const QString& help, std::function<double()> value,
+                             const QString& labels)
+{
+    addCounter(name, help, std::move(value), labels);
+    metrics.back().gauge = true;
+}
+
+void MetricsServer::addHistogram(const QString& name, const QString& help,
+                                 std::function<LatencyHistogram()> histogram, const QString& labels)
+{
+    Metric metric;
+    metric.name = name;
+    metric.help = help;
+    metric.labels = labels;
+    metric.histogram = std::move(histogram);
+    metrics.push_back(std::move(metric));
+}
+
+const std::vector<double>& MetricsServer::bucketBoundsSeconds()
+{
+    static const std::vector<double> bounds = {
+        0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0
+    };
+    return bounds;
+}
+
+// Prometheus wants bucket counts to be cumulative; countAtOrBelow() already is.
+// Its buckets are the histogram's, so each le count is approximate.
+QString MetricsServer::render() const
+{
+    QString text;
+    QStringList described;
+    for (const Metric& metric : metrics) {
+        if (!described.contains(metric.name)) {
+            described.append(metric.name);
+            QString help = metric.help;
+            if (metric.histogram)
+                help += " Bucket counts leave out samples in a ~3% wide bucket straddling le.";
+            text += QString("# HELP %1 %2\n").arg(metric.name, help);
+            text += QString("# TYPE %1 %2\n")
+                        .arg(metric.name, metric.histogram ? "histogram" : metric.gauge ? "gauge" : "counter");
+        }
+
+        if (metric.counter) {
+            QString labels = metric.labels.isEmpty() ? QString() : "{" + metric.labels + "}";
+            text += QString("%1%2 %3\n").arg(metric.name, labels).arg(metric.counter(), 0, 'g', 17);
+            continue;
+        }
+
+        LatencyHistogram histogram = metric.histogram();
+        QString prefix = metric.labels.isEmpty() ? QString() : metric.labels + ",";
+        for (double bound : bucketBoundsSeconds()) {
+            text += QString("%1_bucket{%2le=\"%3\"} %4\n")
+                        .arg(metric.name, prefix)
+                        .arg(bound, 0, 'g', 6)
+                        .arg(histogram.countAtOrBelow(bound * 1000.0));
+        }
+        text += QString("%1_bucket{%2le=\"+Inf\"} %3\n").arg(metric.name, prefix).arg(histogram.getCount());
+
+        QString labels = metric.labels.isEmpty() ? QString() : "{" + metric.labels + "}";
+        text += QString("%1_sum%2 %3\n").arg(metric.name, labels).arg(histogram.getSum() / 1000.0, 0, 'g', 17);
+        text += QString("%1_count%2 %3\n").arg(metric.name, labels).arg(histogram.getCount());
+    }
+    return text;
+}
+
+void MetricsServer::onNewConnection()
+{
+    while (QTcpSocket* socket = server->nextPendingConnection()) {
+        connect(socket, &QTcpSocket::readyRead, this, &MetricsServer::onReadyRead);
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+    }
+}
+
+void MetricsServer::onReadyRead()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket)
+        return;
+
+    // Answer once the request headers are complete; bodies are ignored.
+    const qint64 maxRequestSize = 8192;
+    QByteArray pending = socket->peek(maxRequestSize);
+    if (!pending.contains("\r\n\r\n")) {
+        if (pending.size() >= maxRequestSize)
+            socket->abort();
+        return;
+    }
+    socket->readAll();
+
+    QList<QByteArray> requestLine = pending.left(pending.indexOf("\r\n")).split(' ');
+    QByteArray status = "200 OK";
+    QByteArray body;
+    if (requestLine.size() < 2 || requestLine[0] != "GET") {
+        status = "405 Method Not Allowed";
+    } else if (requestLine[1] != "/metrics") {
+        status = "404 Not Found";
+    } else {
+        body = render().toUtf8();
+    }
+
+    QByteArray response = "HTTP/1.1 " + status + "\r\n"
+                          "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                          "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+                          "Connection: close\r\n\r\n" + body;
+    socket->write(response);
+    socket->disconnectFromHost();
+}
+
+// ------------------------------------------------------------------
+// GameMetrics Implementation
+
+QString GameMetrics::dimensionName(Dimension dimension)
+{
+    switch (dimension) {
+    case ByMode: return "mode";
+    case ByAiStrategy: return "ai_strategy";
+    case ByBoardSize: return "board_size";
+    case ByUser: return "user";
+    default: return QString();
+    }
+}
+
+QString GameMetrics::dimensionKey(Dimension dimension, const GameContext& context)
+{
+    switch (dimension) {
+    case ByMode: return context.mode;
+    case ByAiStrategy: return context.aiStrategy;
+    case ByBoardSize: return context.boardSize > 0 ? QString("%1x%1").arg(context.boardSize) : QString();
+    case ByUser: return context.user;
+    default: return QString();
+    }
+}
+
+void GameMetrics::recordGame(const QString& winner, double durationMs, const GameContext& context)
+{
+    totals.add(winner, durationMs);
+    for (int d = 0; d < DimensionCount; ++d) {
+        QString key = dimensionKey(static_cast<Dimension>(d), context);
+        if (!key.isEmpty())
+            breakdowns[d][key].add(winner, durationMs);
+    }
+}
+
+void GameMetrics::setStats(const QString& dimension, const QString& key, const GameOutcomeStats& stats)
+{
+    if (dimension == "total") {
+        totals = stats;
+        return;
+    }
+    for (int d = 0; d < DimensionCount; ++d) {
+        if (dimension == dimensionName(static_cast<Dimension>(d))) {
+            breakdowns[d][key] = stats;
+            return;
+        }
+    }
+}
+
+void GameMetrics::reset()
+{
+    totals = GameOutcomeStats();
+    for (auto& breakdown : breakdowns)
+        breakdown.clear();
+    gameInProgress = false;
+}
+
+// ------------------------------------------------------------------
+// MetricsExporter Implementation
+
+MetricsExporter::MetricsExporter(const QString& path)
+    : MetricsExporter(path, formatForPath(path))
+{
+}
+
+MetricsExporter::MetricsExporter(const QString& path, Format format)
+    : path(path), format(format), sessionId(QUuid::createUuid().toString(QUuid::WithoutBraces))
+{
+}
+
+MetricsExporter::Format MetricsExporter::formatForPath(const QString& path)
+{
+    return path.endsWith(".csv", Qt::CaseInsensitive) ? Csv : JsonLines;
+}
+
+QJsonObject MetricsExporter::buildMetadata()
+{
+    QJsonObject build;
+    build["qtBuild"] = QT_VERSION_STR;
+    build["qtRuntime"] = qVersion();
+#if defined(__clang__)
+    build["compiler"] = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    build["compiler"] = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    build["compiler"] = QString("msvc %1").arg(_MSC_VER);
+#endif
+#ifdef QT_DEBUG
+    build["buildType"] = "debug";
+#else
+    build["buildType"] = "release";
+#endif
+    build["abi"] = QSysInfo::buildAbi();
+    build["os"] = QSysInfo::prettyProductName();
+    build["cpu"] = QSysInfo::currentCpuArchitecture();
+    if (QCoreApplication::instance()) {
+        build["application"] = QCoreApplication::applicationName();
+        build["version"] = QCoreApplication::applicationVersion();
+    }
+#ifdef TICTACTOE_DISABLE_PROBES
+    build["probes"] = false;
+#else
+    build["probes"] = true;
+#endif
+#ifdef TICTACTOE_SQLITE_STATS
+    build["sqliteStats"] = true;
+#else
+    build["sqliteStats"] = false;
+#endif
+    return build;
+}
+
+// Buckets are listed sparsely as [lower us, upper us, count].
+QJsonObject MetricsExporter::monitorToJson(const PerformanceMonitor& monitor)
+{
+    const LatencyHistogram& histogram = monitor.getHistogram();
+    QJsonArray buckets;
+    for (int i = 0; i < LatencyHistogram::BucketCount; ++i) {
+        quint64 count = histogram.getBucketCount(i);
+        if (count) {
+            buckets.append(QJsonArray{double(LatencyHistogram::bucketLowerBound(i)),
+                                      double(LatencyHistogram::bucketUpperBound(i)), double(count)});
+        }
+    }
+
+    QJsonObject json;
+    json["name"] = monitor.getName();
+    json["count"] = double(histogram.getCount());
+    json["sumMs"] = histogram.getSum();
+    json["meanMs"] = monitor.getAverageTime();
+    json["minMs"] = monitor.getMinTime();
+    json["maxMs"] = monitor.getMaxTime();
+    json["p50Ms"] = monitor.getPercentile(50);
+    json["p90Ms"] = monitor.getPercentile(90);
+    json["p99Ms"] = monitor.getPercentile(99);
+    json["p999Ms"] = monitor.getPercentile(99.9);
+    json["bucketsUs"] = buckets;
+    return json;
+}
+
+static QJsonObject outcomeToJson(const GameOutcomeStats& stats)
+{
+    QJsonObject json;
+    json["games"] = stats.games;
+    json["playerWins"] = stats.playerWins;
+    json["aiWins"] = stats.aiWins;
+    json["draws"] = stats.draws;
+    json["averageDurationMs"] = stats.durationMs.mean;
+    json["stdDevDurationMs"] = stats.durationMs.getStdDev();
+    json["minDurationMs"] = stats.durationMs.min;
+    json["maxDurationMs"] = stats.durationMs.max;
+    return json;
+}
+
+static QJsonObject allocationsToJson()
+{
+    QJsonObject json;
+    for (int s = 0; s < AllocationTracker::SubsystemCount; ++s) {
+        AllocationTracker::Subsystem subsystem = static_cast<AllocationTracker::Subsystem>(s);
+        AllocationStats stats = AllocationTracker::getStats(subsystem);
+        QJsonObject entry;
+        entry["liveBytes"] = double(stats.liveBytes);
+        entry["peakBytes"] = double(stats.peakBytes);
+        entry["allocations"] = double(stats.allocations);
+        entry["deallocations"] = double(stats.deallocations);
+        entry["totalBytes"] = double(stats.totalBytes);
+        json[AllocationTracker::subsystemName(subsystem)] = entry;
+    }
+    return json;
+}
+
+QJsonObject MetricsExporter::gameMetricsToJson(const GameMetrics& metrics)
+{
+    QJsonObject json;
+    json["totalGames"] = metrics.getTotalGames();
+    json["playerWins"] = metrics.getPlayerWins();
+    json["aiWins"] = metrics.getAiWins();
+    json["draws"] = metrics.getDraws();
+    json["averageDurationMs"] = metrics.getAverageGameDuration();
+    json["stdDevDurationMs"] = metrics.getTotals().durationMs.getStdDev();
+
+    QJsonObject breakdowns;
+    for (int d = 0; d < GameMetrics::DimensionCount; ++d) {
+        GameMetrics::Dimension dimension = static_cast<GameMetrics::Dimension>(d);
+        QJsonObject buckets;
+        for (const auto& entry : metrics.getBreakdown(dimension))
+            buckets[entry.first] = outcomeToJson(entry.second);
+        breakdowns[GameMetrics::dimensionName(dimension)] = buckets;
+    }
+    json["breakdowns"] = breakdowns;
+    return json;
+}
+
+QString MetricsExporter::csvHeader()
+{
+    return "timestamp,session,sequence,kind,name,value,count,mean_ms,min_ms,p50_ms,p90_ms,p99_ms,max_ms";
+}
+
+static QString csvField(const QString& field)
+{
+    if (!field.contains(',') && !field.contains('"') && !field.contains('\n'))
+        return field;
+    return '"' + QString(field).replace("\"", "\"\"") + '"';
+}
+
+QString MetricsExporter::csvRow(const QString& timestamp, const QString& kind, const QString& name,
+                                const QString& value, const PerformanceMonitor* monitor, quint64 count) const
+{
+    QStringList fields = {timestamp, sessionId, QString::number(sequence), kind, csvField(name), csvField(value)};
+    if (monitor) {
+        fields << QString::number(monitor->getMeasurementCount())
+               << QString::number(monitor->getAverageTime(), 'f', 3)
+               << QString::number(monitor->getMinTime(), 'f', 3)
+               << QString::number(monitor->getPercentile(50), 'f', 3)
+               << QString::number(monitor->getPercentile(90), 'f', 3)
+               << QString::number(monitor->getPercentile(99), 'f', 3)
+               << QString::number(monitor->getMaxTime(), 'f', 3);
+    } else {
+        fields << (count ? QString::number(count) : QString()) << "" << "" << "" << "" << "" << "";
+    }
+    return fields.join(',') + '\n';
+}
+
+bool MetricsExporter::appendLines(const QByteArray& lines)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qDebug() << "Error opening metrics export:" << file.errorString();
+        return false;
+    }
+    if (file.write(lines) != lines.size()) {
+        qDebug() << "Error writing metrics export:" << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool MetricsExporter::beginSession(const QJsonObject& config)
+{
+    QMutexLocker locker(&writeMutex);
+    sequence = 0;
+    QString timestamp = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+    QJsonObject build = buildMetadata();
+
+    if (format == JsonLines) {
+        QJsonObject record;
+        record["type"] = "session";
+        record["session"] = sessionId;
+        record["timestamp"] = timestamp;
+        record["build"] = build;
+        record["config"] = config;
+        return appendLines(QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n');
+    }
+
+    QString rows;
+    if (QFileInfo(path).size() == 0)
+        rows += csvHeader() + '\n';
+    for (auto it = build.constBegin(); it != build.constEnd(); ++it)
+        rows += csvRow(timestamp, "build", it.key(), it.value().toVariant().toString());
+    for (auto it = config.constBegin(); it != config.constEnd(); ++it)
+        rows += csvRow(timestamp, "config", it.key(), it.value().toVariant().toString());
+    return appendLines(rows.toUtf8());
+}
+
+bool MetricsExporter::appendSnapshot(const std::vector<PerformanceMonitor>& monitors, const GameMetrics& metrics)
+{
+    AllocationScope allocations(AllocationTracker::Monitoring);
+    QMutexLocker locker(&writeMutex);
+    ++sequence;
+    QString timestamp = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+    double rssMB = PerformanceMonitor::getCurrentMemoryUsageMB();
+    QJsonObject game = gameMetricsToJson(metrics);
+
+    if (format == JsonLines) {
+        QJsonArray monitorArray;
+        for (const PerformanceMonitor& monitor : monitors)
+            monitorArray.append(monitorToJson(monitor));
+
+        QJsonObject record;
+        record["type"] = "snapshot";
+        record["session"] = sessionId;
+        record["sequence"] = sequence;
+        record["timestamp"] = timestamp;
+        record["rssMB"] = rssMB;
+        if (AllocationTracker::isEnabled())
+            record["allocations"] = allocationsToJson();
+        record["monitors"] = monitorArray;
+        record["game"] = game;
+        return appendLines(QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n');
+    }
+
+    QString rows = csvRow(timestamp, "resource", "rss_mb", QString::number(rssMB, 'f', 2));
+    if (AllocationTracker::isEnabled()) {
+        QJsonObject allocations = allocationsToJson();
+        for (auto it = allocations.constBegin(); it != allocations.constEnd(); ++it) {
+            QJsonObject fields = it.value().toObject();
+            for (auto field = fields.constBegin(); field != fields.constEnd(); ++field)
+                rows += csvRow(timestamp, "heap", it.key() + '.' + field.key(), field.value().toVariant().toString());
+        }
+    }
+    for (const PerformanceMonitor& monitor : monitors) {
+        rows += csvRow(timestamp, "operation", monitor.getName(), QString(), &monitor);
+        const LatencyHistogram& histogram = monitor.getHistogram();
+        for (int i = 0; i < LatencyHistogram::BucketCount; ++i) {
+            // value is the bucket's upper bound in microseconds.
+            if (quint64 count = histogram.getBucketCount(i)) {
+                rows += csvRow(timestamp, "bucket", monitor.getName(),
+                               QString::number(LatencyHistogram::bucketUpperBound(i)), nullptr, count);
+            }
+        }
+    }
+    // Breakdown values are flattened to names like "mode.PvAI.games".
+    for (auto it = game.constBegin(); it != game.constEnd(); ++it) {
+        if (!it.value().isObject()) {
+            rows += csvRow(timestamp, "game", it.key(), it.value().toVariant().toString());
+            continue;
+        }
+        QJsonObject dimensions = it.value().toObject();
+        for (auto dimension = dimensions.constBegin(); dimension != dimensions.constEnd(); ++dimension) {
+            QJsonObject buckets = dimension.value().toObject();
+            for (auto bucket = buckets.constBegin(); bucket != buckets.constEnd(); ++bucket) {
+                QJsonObject fields = bucket.value().toObject();
+                for (auto field = fields.constBegin(); field != fields.constEnd(); ++field) {
+                    rows += csvRow(timestamp, "game",
+                                   dimension.key() + '.' + bucket.key() + '.' + field.key(),
+                                   field.value().toVariant().toString());
+                }
+            }
+        }
+    }
+    return appendLines(rows.toUtf8());
+}
+
+// ------------------------------------------------------------------
+// DatabaseManager Implementation
+
+static double elapsedMs(const QElapsedTimer& timer)
+{
+    return timer.nsecsElapsed() / 1000000.0;
+}
+
+DatabaseManager::DatabaseManager(const QString& databaseName, const DatabaseProfile& databaseProfile)
+    : databaseName(databaseName), profile(databaseProfile), schemaReady(false),
+      dbPerformanceMonitor("Database Operations"), initializeStats("Initialize")
+{
+    static QAtomicInt nextInstanceId;
+    connectionPrefix = QString("tictactoe-%1").arg(nextInstanceId.fetchAndAddRelaxed(1));
+
+    statementStats = {
+        DatabaseOperationStats("Insert User"),
+        DatabaseOperationStats("Verify User"),
+        DatabaseOperationStats("Update Password"),
+        DatabaseOperationStats("Insert Game"),
+        DatabaseOperationStats("Load History"),
+        DatabaseOperationStats("Update User Stats"),
+        DatabaseOperationStats("Load User Stats"),
+        DatabaseOperationStats("Save Game Metrics"),
+        DatabaseOperationStats("Load Game Metrics"),
+        DatabaseOperationStats("Count History"),
+        DatabaseOperationStats("Load History Page"),
+        DatabaseOperationStats("Load Game Moves")
+    };
+}
+
+DatabaseManager::~DatabaseManager()
+{
+    std::map<QThread*, std::unique_ptr<Connection>> remaining;
+    {
+        QMutexLocker locker(&connectionMutex);
+        remaining.swap(connections);
+    }
+    for (auto& entry : remaining)
+        closeConnection(*entry.second);
+}
+
+bool DatabaseManager::initializeDatabase()
+{
+    ScopedProbe probe("db.initialize");
+    AllocationScope allocations(AllocationTracker::Database);
+    QElapsedTimer timer;
+    timer.start();
+
+    Connection* conn = findConnection();
+    if (!conn)
+        conn = registerConnection(openConnection());
+
+    bool success = conn && createSchema(conn->db) && prepareStatements(*conn);
+    schemaReady = success;
+
+    QMutexLocker locker(&statsMutex);
+    double elapsed = elapsedMs(timer);
+    initializeStats.latency.addMeasurement(elapsed);
+    dbPerformanceMonitor.addMeasurement(elapsed);
+    if (success)
+        initializeStats.rows++;
+    return success;
+}
+
+bool DatabaseManager::createSchema(QSqlDatabase& db)
+{
+    QSqlQuery query(db);
+
+    bool success = query.exec(
+        "CREATE TABLE IF NOT EXISTS users ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "username TEXT UNIQUE NOT NULL, "
+        "password_hash TEXT NOT NULL, "
+        "salt TEXT NOT NULL, "
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP)"
+        );
+
+    if (!success) {
+        qDebug() << "Error creating users table:" << query.lastError().text();
+        return false;
+    }
+
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS game_history ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+        "username TEXT NOT NULL, "
+        "game_mode TEXT NOT NULL, "
+        "winner TEXT NOT NULL, "
+        "moves TEXT NOT NULL, "
+        "timestamp DATETIME DEFAULT CURRENT_TIMESTAMP, "
+        "FOREIGN KEY(username) REFERENCES users(username))"
+        );
+
+    if (!success) {
+        qDebug() << "Error creating game_history table:" << query.lastError().text();
+        return false;
+    }
+
+    if (!ensureColumn(db, "game_history", "duration_ms", "REAL NOT NULL DEFAULT 0"))
+        return false;
+
+    // NOCASE lets the opponent prefix search use the index below.
+    bool opponentExisted = db.record("game_history").contains("opponent");
+    if (!ensureColumn(db, "game_history", "opponent", "TEXT NOT NULL DEFAULT '' COLLATE NOCASE"))
+        return false;
+    if (!opponentExisted && !query.exec("UPDATE game_history SET opponent = 'AI' WHERE game_mode = 'PvAI'")) {
+        qDebug() << "Error backfilling game_history opponents:" << query.lastError().text();
+        return false;
+    }
+
+    // One index per sortable history column so a page is an index range
+    // scan rather than a sort of the user's whole history; the same
+    // indexes serve the mode, winner, date and opponent filters.
+    for (const char* column : { "timestamp", "game_mode", "winner", "opponent" }) {
+        QString sql = QString("CREATE INDEX IF NOT EXISTS idx_game_history_user_%1 "
+                              "ON game_history(username, %1, id)").arg(column);
+        if (!query.exec(sql)) {
+            qDebug() << "Error creating game_history index:" << query.lastError().text();
+            return false;
+        }
+    }
+
+    bool statsTableExisted = db.tables().contains("user_stats");
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS user_stats ("
+        "username TEXT PRIMARY KEY, "
+        "total_games INTEGER NOT NULL DEFAULT 0, "
+        "wins INTEGER NOT NULL DEFAULT 0, "
+        "losses INTEGER NOT NULL DEFAULT 0, "
+        "draws INTEGER NOT NULL DEFAULT 0, "
+        "pvp_games INTEGER NOT NULL DEFAULT 0, "
+        "pvai_games INTEGER NOT NULL DEFAULT 0, "
+        "current_streak INTEGER NOT NULL DEFAULT 0, "
+        "best_win_streak INTEGER NOT NULL DEFAULT 0, "
+        "total_duration_ms REAL NOT NULL DEFAULT 0, "
+        "last_played DATETIME, "
+        "FOREIGN KEY(username) REFERENCES users(username))"
+        );
+
+    // Backfill totals from existing history once; streaks start from zero
+    // because the history predates ordering-aware bookkeeping.
+    if (success && !statsTableExisted) {
+        success = query.exec(
+            "INSERT OR IGNORE INTO user_stats (username, total_games, wins, losses, draws, "
+            "pvp_games, pvai_games, total_duration_ms, last_played) "
+            "SELECT username, COUNT(*), "
+            "SUM(winner IN ('You', 'Player 1')), SUM(winner IN ('AI', 'Player 2')), SUM(winner = 'Draw'), "
+            "SUM(game_mode = 'PvP'), SUM(game_mode = 'PvAI'), SUM(duration_ms), MAX(timestamp) "
+            "FROM game_history GROUP BY username"
+            );
+    }
+
+    if (!success) {
+        qDebug() << "Error creating user_stats table:" << query.lastError().text();
+        return false;
+    }
+
+    success = query.exec(
+        "CREATE TABLE IF NOT EXISTS game_metrics ("
+        "dimension TEXT NOT NULL, "
+        "key TEXT NOT NULL, "
+        "games INTEGER NOT NULL DEFAULT 0, "
+        "player_wins INTEGER NOT NULL DEFAULT 0, "
+        "ai_wins INTEGER NOT NULL DEFAULT 0, "
+        "draws INTEGER NOT NULL DEFAULT 0, "
+        "duration_count INTEGER NOT NULL DEFAULT 0, "
+        "duration_mean_ms REAL NOT NULL DEFAULT 0, "
+        "duration_m2 REAL NOT NULL DEFAULT 0, "
+        "duration_min_ms REAL NOT NULL DEFAULT 0, "
+        "duration_max_ms REAL NOT NULL DEFAULT 0, "
+        "PRIMARY KEY(dimension, key))"
+        );
+
+    if (!success) {
+        qDebug() << "Error creating game_metrics table:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+DatabaseManager::Connection* DatabaseManager::findConnection()
+{
+    QMutexLocker locker(&connectionMutex);
+    auto it = connections.find(QThread::currentThread());
+    return it != connections.end() ? it->second.get() : nullptr;
+}
+
+DatabaseManager::Connection* DatabaseManager::registerConnection(std::unique_ptr<Connection> conn)
+{
+    if (!conn)
+        return nullptr;
+    Connection* raw = conn.get();
+    QMutexLocker locker(&connectionMutex);
+    connections[QThread::currentThread()] = std::move(conn);
+    return raw;
+}
+
+DatabaseManager::Connection* DatabaseManager::threadConnection()
+{
+    if (Connection* conn = findConnection())
+        return conn;
+    if (!schemaReady)
+        return nullptr;
+
+    std::unique_ptr<Connection> conn = openConnection();
+    if (conn && !prepareStatements(*conn)) {
+        closeConnection(*conn);
+        conn.reset();
+    }
+    return registerConnection(std::move(conn));
+}
+
+std::unique_ptr<DatabaseManager::Connection> DatabaseManager::openConnection()
+{
+    QThread* thread = QThread::currentThread();
+    DatabaseProfile connectionProfile;
+    {
+        QMutexLocker locker(&connectionMutex);
+        connectionProfile = profile;
+    }
+
+    auto conn = std::make_unique<Connection>();
+    conn->name = QString("%1-%2").arg(connectionPrefix).arg(reinterpret_cast<quintptr>(thread));
+    conn->db = QSqlDatabase::addDatabase("QSQLITE", conn->name);
+    conn->db.setDatabaseName(databaseName);
+
+    if (!conn->db.open()) {
+        qDebug() << "Error opening database:" << conn->db.lastError().text();
+        closeConnection(*conn);
+        return nullptr;
+    }
+    if (!applyProfile(conn->db, connectionProfile)) {
+        closeConnection(*conn);
+        return nullptr;
+    }
+
+    // Worker threads drop their connection when they finish; the slot runs
+    // in the finishing thread, which owns the connection.
+    QCoreApplication* app = QCoreApplication::instance();
+    if (app && thread != app->thread()) {
+        conn->threadFinished = QObject::connect(thread, &QThread::finished, [this, thread]() {
+            releaseConnection(thread);
+        });
+    }
+    return conn;
+}
+
+void DatabaseManager::closeConnection(Connection& conn)
+{
+    QObject::disconnect(conn.threadFinished);
+    conn.statements.clear();
+    conn.dynamicStatements.clear();
+    if (conn.db.isOpen())
+        conn.db.close();
+    conn.db = QSqlDatabase();
+    QSqlDatabase::removeDatabase(conn.name);
+}
+
+void DatabaseManager::releaseConnection(QThread* thread)
+{
+    std::unique_ptr<Connection> conn;
+    {
+        QMutexLocker locker(&connectionMutex);
+        auto it = connections.find(thread);
+        if (it == connections.end())
+            return;
+        conn = std::move(it->second);
+        connections.erase(it);
+    }
+    closeConnection(*conn);
+}
+
+void DatabaseManager::releaseThreadConnection()
+{
+    releaseConnection(QThread::currentThread());
+}
+
+int DatabaseManager::getConnectionCount() const
+{
+    QMutexLocker locker(&connectionMutex);
+    return static_cast<int>(connections.size());
+}
+
+bool DatabaseManager::prepareStatements(Connection& conn)
+{
+    static const char* const sql[StatementCount] = {
+        "INSERT INTO users (username, password_hash, salt) VALUES (?, ?, ?)",
+        "SELECT password_hash, salt FROM users WHERE username = ?",
+        "UPDATE users SET password_hash = ?, salt = ? WHERE username = ?",
+        "INSERT INTO game_history (username, game_mode, winner, moves, duration_ms, opponent) VALUES (?, ?, ?, ?, ?, ?)",
+        "SELECT game_mode, winner, moves, timestamp, duration_ms, id, opponent FROM game_history WHERE username = ? ORDER BY timestamp DESC",
+        // Column references on the right-hand side of SET see the old row.
+        "INSERT INTO user_stats (username, total_games, wins, losses, draws, pvp_games, pvai_games, "
+        "current_streak, best_win_streak, total_duration_ms, last_played) "
+        "VALUES (?, 1, ?, ?, ?, ?, ?, ?, ?, ?, CURRENT_TIMESTAMP) "
+        "ON CONFLICT(username) DO UPDATE SET "
+        "total_games = total_games + 1, "
+        "wins = wins + excluded.wins, "
+        "losses = losses + excluded.losses, "
+        "draws = draws + excluded.draws, "
+        "pvp_games = pvp_games + excluded.pvp_games, "
+        "pvai_games = pvai_games + excluded.pvai_games, "
+        "current_streak = CASE WHEN excluded.wins = 1 THEN MAX(current_streak, 0) + 1 "
+        "WHEN excluded.losses = 1 THEN MIN(current_streak, 0) - 1 ELSE 0 END, "
+        "best_win_streak = MAX(best_win_streak, CASE WHEN excluded.wins = 1 THEN MAX(current_streak, 0) + 1 ELSE 0 END), "
+        "total_duration_ms = total_duration_ms + excluded.total_duration_ms, "
+        "last_played = excluded.last_played",
+        "SELECT total_games, wins, losses, draws, pvp_games, pvai_games, current_streak, "
+        "best_win_streak, total_duration_ms, last_played FROM user_stats WHERE username = ?",
+        "INSERT OR REPLACE INTO game_metrics (dimension, key, games, player_wins, ai_wins, draws, "
+        "duration_count, duration_mean_ms, duration_m2, duration_min_ms, duration_max_ms) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+        "SELECT dimension, key, games, player_wins, ai_wins, draws, duration_count, "
+        "duration_mean_ms, duration_m2, duration_min_ms, duration_max_ms FROM game_metrics",
+        nullptr,   // counts and pages depend on the filter and sort order;
+        nullptr,   // see countGameHistory() and loadGameHistoryPage()
+        "SELECT moves FROM game_history WHERE id = ?"
+    };
+
+    conn.statements.clear();
+    conn.statements.reserve(StatementCount);
+    conn.dynamicStatements.clear();
+    for (int i = 0; i < StatementCount; ++i) {
+        QSqlQuery query(conn.db);
+        if (sql[i] && !query.prepare(sql[i])) {
+            qDebug() << "Error preparing statement:" << query.lastError().text();
+            conn.statements.clear();
+            return false;
+        }
+        conn.statements.push_back(std::move(query));
+    }
+    return true;
+}
+
+// Prepared once per connection and SQL text, like the fixed statements.
+QSqlQuery* DatabaseManager::dynamicStatement(Connection& conn, const QString& sql)
+{
+    auto it = conn.dynamicStatements.find(sql);
+    if (it == conn.dynamicStatements.end()) {
+        QSqlQuery query(conn.db);
+        if (!query.prepare(sql)) {
+            qDebug() << "Error preparing statement:" << query.lastError().text();
+            return nullptr;
+        }
+        it = conn.dynamicStatements.emplace(sql, std::move(query)).first;
+    }
+    return &it->second;
+}
+
+bool DatabaseManager::ensureColumn(QSqlDatabase& db, const QString& table, const QString& column,
+                                   const QString& definition)
+{
+    if (db.record(table).contains(column))
+        return true;
+
+    QSqlQuery query(db);
+    if (!query.exec(QString("ALTER TABLE %1 ADD COLUMN %2 %3").arg(table, column, definition))) {
+        qDebug() << "Error adding column" << column << "to" << table << ":" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseManager::setProfile(const DatabaseProfile& databaseProfile)
+{
+    {
+        QMutexLocker locker(&connectionMutex);
+        profile = databaseProfile;
+    }
+    // Other threads pick the profile up when they next open a connection.
+    Connection* conn = findConnection();
+    return conn ? applyProfile(conn->db, databaseProfile) : true;
+}
+
+DatabaseProfile DatabaseManager::getProfile() const
+{
+    QMutexLocker locker(&connectionMutex);
+    return profile;
+}
 
-    double cpuUsage = 0.0;
-    if (sys != 0) {
-        cpuUsage = (1.0 - ((double)idleDiff / sys)) * 100.0;
+bool DatabaseManager::applyProfile(QSqlDatabase& db, const DatabaseProfile& databaseProfile)
+{
+    // PRAGMA values cannot be bound, so the statements are built from the
+    // fixed preset strings.
+    const QStringList pragmas = {
+        QString("PRAGMA journal_mode = %1").arg(databaseProfile.journalMode),
+        QString("PRAGMA synchronous = %1").arg(databaseProfile.synchronous),
+        QString("PRAGMA temp_store = %1").arg(databaseProfile.tempStore),
+        QString("PRAGMA cache_size = -%1").arg(databaseProfile.cacheSizeKB),
+        QString("PRAGMA mmap_size = %1").arg(databaseProfile.mmapSizeBytes)
+    };
+
+    QSqlQuery query(db);
+    for (const QString& pragma : pragmas) {
+        if (!query.exec(pragma)) {
+            qDebug() << "Error applying" << pragma << ":" << query.lastError().text();
+            return false;
+        }
     }
+    return true;
+}
 
-    lastIdleTime = idle;
-    lastKernelTime = kernel;
-    lastUserTime = user;
+#ifdef TICTACTOE_SQLITE_STATS
+// The QSQLITE driver hands out its native handles as QVariants holding
+// "sqlite3*" and "sqlite3_stmt*".
+template <typename Handle>
+static Handle* sqliteHandle(const QVariant& handle, const char* typeName)
+{
+    if (!handle.isValid() || qstrcmp(handle.typeName(), typeName) != 0)
+        return nullptr;
+    return *static_cast<Handle* const*>(handle.constData());
+}
+#endif
 
-    return cpuUsage;
+void DatabaseManager::recordStatement(Connection& conn, Statement statement, double elapsed,
+                                      quint64 rows, quint64 bytes, QSqlQuery* query, bool countOperation)
+{
+    quint64 vmSteps = 0;
+#ifdef TICTACTOE_SQLITE_STATS
+    if (!query)
+        query = &conn.statements[statement];
+    if (sqlite3_stmt* stmt = sqliteHandle<sqlite3_stmt>(query->result()->handle(), "sqlite3_stmt*"))
+        vmSteps = static_cast<quint64>(sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_VM_STEP, 1));
 #else
-    return 0.0;
+    Q_UNUSED(conn);
+    Q_UNUSED(query);
 #endif
-}
 
-// ------------------------------------------------------------------
-// DatabaseManager Implementation
+    QMutexLocker locker(&statsMutex);
+    DatabaseOperationStats& stats = statementStats[statement];
+    stats.latency.addMeasurement(elapsed);
+    stats.rows += rows;
+    stats.bytes += bytes;
+    stats.vmSteps += vmSteps;
+    if (countOperation)
+        dbPerformanceMonitor.addMeasurement(elapsed);
+}
 
-DatabaseManager::DatabaseManager() : dbPerformanceMonitor("Database Operations")
+// A failed COMMIT (e.g. SQLITE_BUSY) leaves the transaction open; the
+// caller must roll back so later statements on the connection autocommit.
+bool DatabaseManager::commitTransaction(Connection& conn, const char* what)
 {
-    db = QSqlDatabase::addDatabase("QSQLITE");
-    db.setDatabaseName("tictactoe.db");
+    if (conn.db.commit())
+        return true;
+    qDebug() << "Error committing" << what << "transaction:" << conn.db.lastError().text();
+    return false;
 }
 
-DatabaseManager::~DatabaseManager()
+// The aggregate monitor counts public calls, not statements.
+void DatabaseManager::recordOperation(double elapsed)
 {
-    if (db.isOpen()) {
-        db.close();
-    }
+    QMutexLocker locker(&statsMutex);
+    dbPerformanceMonitor.addMeasurement(elapsed);
 }
 
-bool DatabaseManager::initializeDatabase()
+PerformanceMonitor DatabaseManager::getPerformanceMonitor() const
 {
-    dbPerformanceMonitor.startMeasurement();
-
-    if (!db.open()) {
-        qDebug() << "Error opening database:" << db.lastError().text();
-        dbPerformanceMonitor.stopMeasurement();
-        return false;
-    }
+    QMutexLocker locker(&statsMutex);
+    return dbPerformanceMonitor;
+}
 
-    QSqlQuery query;
+DatabaseOperationStats DatabaseManager::getStatementStats(Statement statement) const
+{
+    QMutexLocker locker(&statsMutex);
+    return statementStats[statement];
+}
 
-    bool success = query.exec(
-        "CREATE TABLE IF NOT EXISTS users ("
-        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
-        "username TEXT UNIQUE NOT NULL, "
-        "password_hash TEXT NOT NULL, "
-        "salt TEXT NOT NULL, "
-        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP)"
-        );
+DatabaseOperationStats DatabaseManager::getInitializeStats() const
+{
+    QMutexLocker locker(&statsMutex);
+    return initializeStats;
+}
 
-    if (!success) {
-        qDebug() << "Error creating users table:" << query.lastError().text();
-        dbPerformanceMonitor.stopMeasurement();
-        return false;
+DatabaseEngineStats DatabaseManager::getEngineStats()
+{
+    DatabaseEngineStats engine;
+#ifdef TICTACTOE_SQLITE_STATS
+    Connection* conn = findConnection();
+    if (sqlite3* handle = conn ? sqliteHandle<sqlite3>(conn->db.driver()->handle(), "sqlite3*") : nullptr) {
+        int highwater = 0;
+        engine.available = true;
+        sqlite3_db_status(handle, SQLITE_DBSTATUS_CACHE_HIT, &engine.cacheHits, &highwater, 0);
+        sqlite3_db_status(handle, SQLITE_DBSTATUS_CACHE_MISS, &engine.cacheMisses, &highwater, 0);
+        sqlite3_db_status(handle, SQLITE_DBSTATUS_CACHE_USED, &engine.cacheUsedBytes, &highwater, 0);
     }
+#endif
+    return engine;
+}
 
-    success = query.exec(
-        "CREATE TABLE IF NOT EXISTS game_history ("
-        "id INTEGER PRIMARY KEY AUTOINCREMENT, "
-        "username TEXT NOT NULL, "
-        "game_mode TEXT NOT NULL, "
-        "winner TEXT NOT NULL, "
-        "moves TEXT NOT NULL, "
-        "timestamp DATETIME DEFAULT CURRENT_TIMESTAMP, "
-        "FOREIGN KEY(username) REFERENCES users(username))"
-        );
+QString DatabaseManager::getProfileReport()
+{
+    QStringList lines;
+    auto describe = [&lines](const DatabaseOperationStats& stats) {
+        const PerformanceMonitor& latency = stats.latency;
+        if (latency.getMeasurementCount() == 0)
+            return;
+        lines << QString("%1: n=%2 p50=%3 p95=%4 p99=%5 max=%6 ms, rows=%7, bytes=%8, vm steps=%9")
+                     .arg(latency.getName())
+                     .arg(static_cast<qulonglong>(latency.getMeasurementCount()))
+                     .arg(latency.getPercentile(50), 0, 'f', 2)
+                     .arg(latency.getPercentile(95), 0, 'f', 2)
+                     .arg(latency.getPercentile(99), 0, 'f', 2)
+                     .arg(latency.getMaxTime(), 0, 'f', 2)
+                     .arg(static_cast<qulonglong>(stats.rows))
+                     .arg(static_cast<qulonglong>(stats.bytes))
+                     .arg(static_cast<qulonglong>(stats.vmSteps));
+    };
 
-    if (!success) {
-        qDebug() << "Error creating game_history table:" << query.lastError().text();
-        dbPerformanceMonitor.stopMeasurement();
-        return false;
+    {
+        QMutexLocker locker(&statsMutex);
+        describe(initializeStats);
+        for (const DatabaseOperationStats& stats : statementStats)
+            describe(stats);
     }
 
-    dbPerformanceMonitor.stopMeasurement();
-    return true;
+    DatabaseEngineStats engine = getEngineStats();
+    if (engine.available) {
+        int lookups = engine.cacheHits + engine.cacheMisses;
+        lines << QString("SQLite page cache: hits=%1 misses=%2 (%3% hit rate), used=%4 KB")
+                     .arg(engine.cacheHits)
+                     .arg(engine.cacheMisses)
+                     .arg(lookups ? 100.0 * engine.cacheHits / lookups : 0.0, 0, 'f', 1)
+                     .arg(engine.cacheUsedBytes / 1024);
+    }
+    return lines.join("\n");
 }
 
 QString DatabaseManager::generateSalt()
@@ -132,139 +1709,548 @@ QString DatabaseManager::hashPassword(const QString& password, const QString& sa
 
 bool DatabaseManager::saveUser(const QString& username, const QString& password)
 {
-    dbPerformanceMonitor.startMeasurement();
+    ScopedProbe probe("db.saveUser");
+    AllocationScope allocations(AllocationTracker::Database);
+    Connection* conn = threadConnection();
+    if (!conn)
+        return false;
+    QElapsedTimer timer;
+    timer.start();
 
     QString salt = generateSalt();
     QString hashedPassword = hashPassword(password, salt);
 
-    QSqlQuery query;
-    query.prepare("INSERT INTO users (username, password_hash, salt) VALUES (?, ?, ?)");
-    query.addBindValue(username);
-    query.addBindValue(hashedPassword);
-    query.addBindValue(salt);
+    QSqlQuery& query = conn->statements[InsertUserStatement];
+    query.bindValue(0, username);
+    query.bindValue(1, hashedPassword);
+    query.bindValue(2, salt);
 
     bool result = query.exec();
     if (!result) {
         qDebug() << "Error saving user:" << query.lastError().text();
     }
 
-    dbPerformanceMonitor.stopMeasurement();
+    recordStatement(*conn, InsertUserStatement, elapsedMs(timer), result ? 1 : 0,
+                    username.size() + hashedPassword.size() + salt.size());
     return result;
 }
 
 bool DatabaseManager::verifyUser(const QString& username, const QString& password)
 {
-    dbPerformanceMonitor.startMeasurement();
+    ScopedProbe probe("db.verifyUser");
+    AllocationScope allocations(AllocationTracker::Database);
+    Connection* conn = threadConnection();
+    if (!conn)
+        return false;
+    QElapsedTimer timer;
+    timer.start();
 
-    QSqlQuery query;
-    query.prepare("SELECT password_hash, salt FROM users WHERE username = ?");
-    query.addBindValue(username);
+    QSqlQuery& query = conn->statements[VerifyUserStatement];
+    query.bindValue(0, username);
 
     bool result = false;
+    quint64 rows = 0;
+    quint64 bytes = username.size();
     if (query.exec() && query.next()) {
         QString storedHash = query.value(0).toString();
         QString salt = query.value(1).toString();
         QString inputHash = hashPassword(password, salt);
         result = (storedHash == inputHash);
+        rows = 1;
+        bytes += storedHash.size() + salt.size();
     }
+    query.finish();
 
-    dbPerformanceMonitor.stopMeasurement();
+    recordStatement(*conn, VerifyUserStatement, elapsedMs(timer), rows, bytes);
     return result;
 }
 
 bool DatabaseManager::updateUserPassword(const QString& username, const QString& newPassword)
 {
-    dbPerformanceMonitor.startMeasurement();
+    ScopedProbe probe("db.updateUserPassword");
+    AllocationScope allocations(AllocationTracker::Database);
+    Connection* conn = threadConnection();
+    if (!conn)
+        return false;
+    QElapsedTimer timer;
+    timer.start();
 
     QString salt = generateSalt();
     QString hashedPassword = hashPassword(newPassword, salt);
 
-    QSqlQuery query;
-    query.prepare("UPDATE users SET password_hash = ?, salt = ? WHERE username = ?");
-    query.addBindValue(hashedPassword);
-    query.addBindValue(salt);
-    query.addBindValue(username);
+    QSqlQuery& query = conn->statements[UpdatePasswordStatement];
+    query.bindValue(0, hashedPassword);
+    query.bindValue(1, salt);
+    query.bindValue(2, username);
 
     bool result = query.exec() && query.numRowsAffected() > 0;
     if (!result) {
         qDebug() << "Error updating password:" << query.lastError().text();
     }
 
-    dbPerformanceMonitor.stopMeasurement();
+    recordStatement(*conn, UpdatePasswordStatement, elapsedMs(timer), result ? 1 : 0,
+                    username.size() + hashedPassword.size() + salt.size());
     return result;
 }
 
 bool DatabaseManager::saveGameRecord(const QString& username, const GameRecord& record)
 {
-    dbPerformanceMonitor.startMeasurement();
+    ScopedProbe probe("db.saveGameRecord");
+    AllocationScope allocations(AllocationTracker::Database);
+    Connection* conn = threadConnection();
+    if (!conn)
+        return false;
+    QElapsedTimer timer;
+    timer.start();
+
+    QString movesStr = serializeMoves(record.moves);
+
+    QSqlQuery& query = conn->statements[InsertGameStatement];
+    query.bindValue(0, username);
+    query.bindValue(1, QString::fromStdString(record.mode));
+    query.bindValue(2, QString::fromStdString(record.winner));
+    query.bindValue(3, movesStr);
+    query.bindValue(4, record.durationMs);
+    query.bindValue(5, record.opponent);
+
+    // The history row and the stats row commit together, so one game costs
+    // a single journal sync; without the transaction they must not run.
+    if (!conn->db.transaction()) {
+        qDebug() << "Error starting game record transaction:" << conn->db.lastError().text();
+        return false;
+    }
+    bool result = query.exec();
+    if (!result) {
+        qDebug() << "Error saving game record:" << query.lastError().text();
+    }
+    recordStatement(*conn, InsertGameStatement, elapsedMs(timer), result ? 1 : 0,
+                    username.size() + record.mode.size() + record.winner.size() + movesStr.size() + record.opponent.size(),
+                    nullptr, false);
+
+    result = result && updateUserStats(*conn, username, record) && commitTransaction(*conn, "game record");
+    if (!result)
+        conn->db.rollback();
+    recordOperation(elapsedMs(timer));
+    return result;
+}
+
+bool DatabaseManager::updateUserStats(Connection& conn, const QString& username, const GameRecord& record)
+{
+    ScopedProbe probe("db.updateUserStats");
+    AllocationScope allocations(AllocationTracker::Database);
+    QElapsedTimer timer;
+    timer.start();
+
+    int win = (record.winner == "You" || record.winner == "Player 1") ? 1 : 0;
+    int loss = (record.winner == "AI" || record.winner == "Player 2") ? 1 : 0;
+    int draw = (!win && !loss) ? 1 : 0;
+
+    QSqlQuery& query = conn.statements[UpdateUserStatsStatement];
+    query.bindValue(0, username);
+    query.bindValue(1, win);
+    query.bindValue(2, loss);
+    query.bindValue(3, draw);
+    query.bindValue(4, record.mode == "PvP" ? 1 : 0);
+    query.bindValue(5, record.mode == "PvAI" ? 1 : 0);
+    query.bindValue(6, win - loss);
+    query.bindValue(7, win);
+    query.bindValue(8, record.durationMs);
+
+    bool result = query.exec();
+    if (!result) {
+        qDebug() << "Error updating user stats:" << query.lastError().text();
+    }
+
+    recordStatement(conn, UpdateUserStatsStatement, elapsedMs(timer), result ? 1 : 0, username.size(), nullptr, false);
+    return result;
+}
+
+UserStats DatabaseManager::loadUserStats(const QString& username)
+{
+    ScopedProbe probe("db.loadUserStats");
+    AllocationScope allocations(AllocationTracker::Database);
+    UserStats stats;
+    Connection* conn = threadConnection();
+    if (!conn)
+        return stats;
+    QElapsedTimer timer;
+    timer.start();
+
+    QSqlQuery& query = conn->statements[LoadUserStatsStatement];
+    query.bindValue(0, username);
+
+    quint64 rows = 0;
+    if (query.exec() && query.next()) {
+        stats.totalGames = query.value(0).toInt();
+        stats.wins = query.value(1).toInt();
+        stats.losses = query.value(2).toInt();
+        stats.draws = query.value(3).toInt();
+        stats.pvpGames = query.value(4).toInt();
+        stats.pvaiGames = query.value(5).toInt();
+        stats.currentStreak = query.value(6).toInt();
+        stats.bestWinStreak = query.value(7).toInt();
+        stats.totalDurationMs = query.value(8).toDouble();
+        stats.lastPlayed = query.value(9).toString();
+        rows = 1;
+    }
+    query.finish();
 
+    recordStatement(*conn, LoadUserStatsStatement, elapsedMs(timer), rows, username.size());
+    return stats;
+}
+
+QString DatabaseManager::serializeMoves(const std::vector<Move>& moves)
+{
     QString movesStr;
-    for (size_t i = 0; i < record.moves.size(); ++i) {
-        const Move& m = record.moves[i];
+    for (size_t i = 0; i < moves.size(); ++i) {
+        const Move& m = moves[i];
         movesStr += QString::number(m.row) + "-" + QString::number(m.col) + "-" + QString(m.player);
-        if (i < record.moves.size() - 1) {
+        if (m.offsetMs >= 0 && m.thinkMs >= 0.0)
+            movesStr += "-" + QString::number(m.offsetMs) + "-" + QString::number(m.thinkMs, 'f', 1);
+        if (i < moves.size() - 1) {
             movesStr += ";";
         }
     }
+    return movesStr;
+}
+
+// Older rows have no timings; their moves keep offsetMs/thinkMs at -1.
+std::vector<Move> DatabaseManager::parseMoves(const QString& movesStr)
+{
+    std::vector<Move> moves;
+    if (movesStr.isEmpty())
+        return moves;
+
+    QStringList moveTokens = movesStr.split(";");
+    moves.reserve(moveTokens.size());
+    for (const QString& token : moveTokens) {
+        QStringList parts = token.split("-");
+        if ((parts.size() == 3 || parts.size() == 5) && !parts[2].isEmpty()) {
+            Move m;
+            m.row = parts[0].toInt();
+            m.col = parts[1].toInt();
+            m.player = parts[2].at(0).toLatin1();
+            if (parts.size() == 5) {
+                m.offsetMs = parts[3].toLongLong();
+                m.thinkMs = parts[4].toDouble();
+            }
+            moves.push_back(m);
+        }
+    }
+    return moves;
+}
+
+// Rows hold the running state rather than increments, so only the rows
+// this game touched are rewritten.
+bool DatabaseManager::saveGameMetrics(const GameMetrics& metrics, const GameContext& context)
+{
+    ScopedProbe probe("db.saveGameMetrics");
+    AllocationScope allocations(AllocationTracker::Database);
+    Connection* conn = threadConnection();
+    if (!conn)
+        return false;
+    QElapsedTimer timer;
+    timer.start();
+
+    struct MetricsRow {
+        QString dimension;
+        QString key;
+        const GameOutcomeStats* stats;
+    };
+    std::vector<MetricsRow> rows = { { "total", QString(), &metrics.getTotals() } };
+    for (int d = 0; d < GameMetrics::DimensionCount; ++d) {
+        GameMetrics::Dimension dimension = static_cast<GameMetrics::Dimension>(d);
+        QString key = GameMetrics::dimensionKey(dimension, context);
+        auto it = metrics.getBreakdown(dimension).find(key);
+        if (!key.isEmpty() && it != metrics.getBreakdown(dimension).end())
+            rows.push_back({ GameMetrics::dimensionName(dimension), key, &it->second });
+    }
+
+    QSqlQuery& query = conn->statements[SaveGameMetricsStatement];
+    if (!conn->db.transaction()) {
+        qDebug() << "Error starting game metrics transaction:" << conn->db.lastError().text();
+        return false;
+    }
+    bool result = true;
+    quint64 bytes = 0;
+    for (const MetricsRow& row : rows) {
+        const RunningStats& duration = row.stats->durationMs;
+        query.bindValue(0, row.dimension);
+        query.bindValue(1, row.key);
+        query.bindValue(2, row.stats->games);
+        query.bindValue(3, row.stats->playerWins);
+        query.bindValue(4, row.stats->aiWins);
+        query.bindValue(5, row.stats->draws);
+        query.bindValue(6, static_cast<qlonglong>(duration.count));
+        query.bindValue(7, duration.mean);
+        query.bindValue(8, duration.m2);
+        query.bindValue(9, duration.min);
+        query.bindValue(10, duration.max);
+        if (!query.exec()) {
+            qDebug() << "Error saving game metrics:" << query.lastError().text();
+            result = false;
+            break;
+        }
+        bytes += row.dimension.size() + row.key.size();
+    }
+    result = result && commitTransaction(*conn, "game metrics");
+    if (!result)
+        conn->db.rollback();
+
+    recordStatement(*conn, SaveGameMetricsStatement, elapsedMs(timer), result ? rows.size() : 0, bytes);
+    return result;
+}
 
-    QSqlQuery query;
-    query.prepare("INSERT INTO game_history (username, game_mode, winner, moves) VALUES (?, ?, ?, ?)");
-    query.addBindValue(username);
-    query.addBindValue(QString::fromStdString(record.mode));
-    query.addBindValue(QString::fromStdString(record.winner));
-    query.addBindValue(movesStr);
+bool DatabaseManager::loadGameMetrics(GameMetrics& metrics)
+{
+    ScopedProbe probe("db.loadGameMetrics");
+    AllocationScope allocations(AllocationTracker::Database);
+    Connection* conn = threadConnection();
+    if (!conn)
+        return false;
+    QElapsedTimer timer;
+    timer.start();
 
+    QSqlQuery& query = conn->statements[LoadGameMetricsStatement];
     bool result = query.exec();
-    if (!result) {
-        qDebug() << "Error saving game record:" << query.lastError().text();
+    quint64 rows = 0;
+    quint64 bytes = 0;
+    if (result) {
+        metrics.reset();
+        while (query.next()) {
+            GameOutcomeStats stats;
+            stats.games = query.value(2).toInt();
+            stats.playerWins = query.value(3).toInt();
+            stats.aiWins = query.value(4).toInt();
+            stats.draws = query.value(5).toInt();
+            stats.durationMs.count = query.value(6).toULongLong();
+            stats.durationMs.mean = query.value(7).toDouble();
+            stats.durationMs.m2 = query.value(8).toDouble();
+            stats.durationMs.min = query.value(9).toDouble();
+            stats.durationMs.max = query.value(10).toDouble();
+
+            QString dimension = query.value(0).toString();
+            QString key = query.value(1).toString();
+            metrics.setStats(dimension, key, stats);
+            rows++;
+            bytes += dimension.size() + key.size();
+        }
+    } else {
+        qDebug() << "Error loading game metrics:" << query.lastError().text();
     }
+    query.finish();
 
-    dbPerformanceMonitor.stopMeasurement();
+    recordStatement(*conn, LoadGameMetricsStatement, elapsedMs(timer), rows, bytes);
     return result;
 }
 
 std::vector<GameRecord> DatabaseManager::loadGameHistory(const QString& username)
 {
-    dbPerformanceMonitor.startMeasurement();
-
+    ScopedProbe probe("db.loadGameHistory");
+    // Untagged here: the rows are charged to the caller, e.g. GameHistory.
     std::vector<GameRecord> history;
+    Connection* conn = threadConnection();
+    if (!conn)
+        return history;
+    QElapsedTimer timer;
+    timer.start();
 
-    QSqlQuery query;
-    query.prepare("SELECT game_mode, winner, moves, timestamp FROM game_history WHERE username = ? ORDER BY timestamp DESC");
-    query.addBindValue(username);
+    QSqlQuery& query = conn->statements[LoadHistoryStatement];
+    query.bindValue(0, username);
 
+    quint64 bytes = username.size();
     if (query.exec()) {
         while (query.next()) {
             GameRecord record;
             record.mode = query.value(0).toString().toStdString();
             record.winner = query.value(1).toString().toStdString();
             record.timestamp = query.value(3).toString();
+            record.durationMs = query.value(4).toDouble();
+            record.id = query.value(5).toLongLong();
+            record.opponent = query.value(6).toString();
 
             QString movesStr = query.value(2).toString();
-            if (!movesStr.isEmpty()) {
-                QStringList moveTokens = movesStr.split(";");
-                for (const QString& token : moveTokens) {
-                    QStringList parts = token.split("-");
-                    if (parts.size() == 3) {
-                        Move m;
-                        m.row = parts[0].toInt();
-                        m.col = parts[1].toInt();
-                        m.player = parts[2].at(0).toLatin1();
-                        record.moves.push_back(m);
-                    }
-                }
-            }
+            bytes += record.mode.size() + record.winner.size() + record.timestamp.size() + movesStr.size()
+                     + record.opponent.size();
+            record.moves = parseMoves(movesStr);
 
             history.push_back(record);
         }
     } else {
         qDebug() << "Error loading game history:" << query.lastError().text();
     }
+    query.finish();
 
-    dbPerformanceMonitor.stopMeasurement();
+    recordStatement(*conn, LoadHistoryStatement, elapsedMs(timer), history.size(), bytes);
     return history;
 }
 
+QString DatabaseManager::formatTimestamp(const QDateTime& time)
+{
+    return time.toUTC().toString("yyyy-MM-dd HH:mm:ss");
+}
+
+// Appends the filter's predicates to a WHERE clause; bindHistoryFilter()
+// binds their values in the same order.
+static QString historyFilterSql(const HistoryFilter& filter)
+{
+    QString sql;
+    if (!filter.mode.empty())
+        sql += " AND game_mode = ?";
+    if (!filter.winner.empty())
+        sql += " AND winner = ?";
+    if (!filter.opponent.isEmpty())
+        sql += " AND opponent LIKE ? ESCAPE '\\'";
+    if (filter.from.isValid())
+        sql += " AND timestamp >= ?";
+    if (filter.to.isValid())
+        sql += " AND timestamp < ?";
+    return sql;
+}
+
+static void bindHistoryFilter(QSqlQuery& query, int& index, const HistoryFilter& filter)
+{
+    if (!filter.mode.empty())
+        query.bindValue(index++, QString::fromStdString(filter.mode));
+    if (!filter.winner.empty())
+        query.bindValue(index++, QString::fromStdString(filter.winner));
+    if (!filter.opponent.isEmpty()) {
+        QString pattern = filter.opponent;
+        pattern.replace('\\', "\\\\").replace('%', "\\%").replace('_', "\\_");
+        query.bindValue(index++, pattern + '%');
+    }
+    if (filter.from.isValid())
+        query.bindValue(index++, DatabaseManager::formatTimestamp(filter.from));
+    if (filter.to.isValid())
+        query.bindValue(index++, DatabaseManager::formatTimestamp(filter.to));
+}
+
+int DatabaseManager::countGameHistory(const QString& username, const HistoryFilter& filter)
+{
+    ScopedProbe probe("db.countGameHistory");
+    AllocationScope allocations(AllocationTracker::Database);
+    Connection* conn = threadConnection();
+    if (!conn)
+        return 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    QSqlQuery* query = dynamicStatement(*conn, "SELECT COUNT(*) FROM game_history WHERE username = ?"
+                                               + historyFilterSql(filter));
+    if (!query)
+        return 0;
+    int index = 0;
+    query->bindValue(index++, username);
+    bindHistoryFilter(*query, index, filter);
+
+    int count = 0;
+    if (query->exec() && query->next()) {
+        count = query->value(0).toInt();
+    } else {
+        qDebug() << "Error counting game history:" << query->lastError().text();
+    }
+    query->finish();
+
+    recordStatement(*conn, CountHistoryStatement, elapsedMs(timer), 1, username.size(), query);
+    return count;
+}
+
+// Rows are ordered by (sort column, id) so ties page deterministically,
+// and each page continues from the previous page's last key instead of an
+// OFFSET, which would rescan every skipped row.
+std::vector<GameRecord> DatabaseManager::loadGameHistoryPage(const QString& username, const HistoryFilter& filter,
+                                                             HistorySortColumn column, Qt::SortOrder order,
+                                                             int limit, const GameRecord* after)
+{
+    ScopedProbe probe("db.loadGameHistoryPage");
+    std::vector<GameRecord> page;
+    Connection* conn = threadConnection();
+    if (!conn || limit <= 0)
+        return page;
+    QElapsedTimer timer;
+    timer.start();
+
+    static const char* const sortColumns[] = { "timestamp", "game_mode", "winner", "opponent" };
+    const QString sortColumn = sortColumns[column];
+    const bool ascending = (order == Qt::AscendingOrder);
+
+    QString sql = "SELECT game_mode, winner, timestamp, duration_ms, id, opponent FROM game_history WHERE username = ?"
+                  + historyFilterSql(filter);
+    if (after)
+        sql += QString(" AND (%1, id) %2 (?, ?)").arg(sortColumn, ascending ? ">" : "<");
+    sql += QString(" ORDER BY %1 %2, id %2 LIMIT ?").arg(sortColumn, ascending ? "ASC" : "DESC");
+
+    QSqlQuery* query = dynamicStatement(*conn, sql);
+    if (!query)
+        return page;
+
+    int index = 0;
+    query->bindValue(index++, username);
+    bindHistoryFilter(*query, index, filter);
+    if (after) {
+        QString key = column == SortByMode ? QString::fromStdString(after->mode)
+                    : column == SortByWinner ? QString::fromStdString(after->winner)
+                    : column == SortByOpponent ? after->opponent
+                    : after->timestamp;
+        query->bindValue(index++, key);
+        query->bindValue(index++, after->id);
+    }
+    query->bindValue(index++, limit);
+
+    quint64 bytes = username.size();
+    page.reserve(limit);
+    if (query->exec()) {
+        while (query->next()) {
+            GameRecord record;
+            record.mode = query->value(0).toString().toStdString();
+            record.winner = query->value(1).toString().toStdString();
+            record.timestamp = query->value(2).toString();
+            record.durationMs = query->value(3).toDouble();
+            record.id = query->value(4).toLongLong();
+            record.opponent = query->value(5).toString();
+            bytes += record.mode.size() + record.winner.size() + record.timestamp.size() + record.opponent.size();
+            page.push_back(std::move(record));
+        }
+    } else {
+        qDebug() << "Error loading game history page:" << query->lastError().text();
+    }
+    query->finish();
+
+    recordStatement(*conn, LoadHistoryPageStatement, elapsedMs(timer), page.size(), bytes, query);
+    return page;
+}
+
+std::vector<Move> DatabaseManager::loadGameMoves(qint64 gameId)
+{
+    ScopedProbe probe("db.loadGameMoves");
+    // Untagged like loadGameHistory: the moves belong to the caller.
+    std::vector<Move> moves;
+    Connection* conn = threadConnection();
+    if (!conn)
+        return moves;
+    QElapsedTimer timer;
+    timer.start();
+
+    QSqlQuery& query = conn->statements[LoadGameMovesStatement];
+    query.bindValue(0, gameId);
+    quint64 bytes = 0;
+    int rows = 0;
+    if (query.exec()) {
+        if (query.next()) {
+            QString movesStr = query.value(0).toString();
+            bytes = movesStr.size();
+            moves = parseMoves(movesStr);
+            rows = 1;
+        }
+    } else {
+        qDebug() << "Error loading game moves:" << query.lastError().text();
+    }
+    query.finish();
+
+    recordStatement(*conn, LoadGameMovesStatement, elapsedMs(timer), rows, bytes);
+    return moves;
+}
+
 // ------------------------------------------------------------------
 // Helper functions for minimax evaluation
 
@@ -290,28 +2276,275 @@ static bool evalIsFull(const std::vector<std::vector<char>> &board) {
     return true;
 }
 
+// ------------------------------------------------------------------
+// BoardTheme Implementation
+
+// The colours the board has always used.
+const BoardTheme& BoardTheme::classic()
+{
+    static const BoardTheme theme = [] {
+        BoardTheme classic;
+        classic.background[EmptyCell] = QBrush(QColor("#f0f0f0"));
+        classic.background[XCell] = QBrush(QColor("#87CEFA"));
+        classic.background[OCell] = QBrush(QColor("#FFA07A"));
+        classic.glyph[XCell] = "X";
+        classic.glyph[OCell] = "O";
+        classic.borderPen = QPen(QColor("#cccccc"), 1);
+        classic.glyphPen = QPen(Qt::black);
+        classic.focusPen = QPen(QColor("#1e6fd9"), 3);
+        classic.disabledShade = QBrush(QColor(255, 255, 255, 110));
+        return classic;
+    }();
+    return theme;
+}
+
+// ------------------------------------------------------------------
+// BoardView Implementation
+
+BoardView::BoardView(int size, QWidget* parent)
+    : QWidget(parent), boardSize(0), cellSize(MaxCellSize), interactive(true),
+      pressedCell(-1, -1), cursorCell(0, 0), clickNs(0), theme(BoardTheme::classic()), tileRatio(0.0)
+{
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setFocusPolicy(Qt::StrongFocus);
+    setAccessibleName("Game board");
+    setBoardSize(size);
+}
+
+void BoardView::setBoardSize(int size)
+{
+    boardSize = std::max(size, 1);
+    cellSize = qBound(static_cast<int>(MinCellSize), MaxBoardExtent / boardSize, static_cast<int>(MaxCellSize));
+    cells.assign(static_cast<size_t>(boardSize * boardSize), ' ');
+    cursorCell = QPoint(std::min(cursorCell.x(), boardSize - 1), std::min(cursorCell.y(), boardSize - 1));
+    updateAccessibleDescription();
+    tileRatio = 0.0;
+    setFixedSize(boardSize * cellSize, boardSize * cellSize);
+    update();
+}
+
+void BoardView::setCell(int row, int col, char mark)
+{
+    if (row < 0 || row >= boardSize || col < 0 || col >= boardSize)
+        return;
+    char& cell = cells[static_cast<size_t>(row * boardSize + col)];
+    if (cell == mark)
+        return;
+    cell = mark;
+    update(cellRect(row, col));
+    if (QPoint(row, col) == cursorCell)
+        updateAccessibleDescription();
+}
+
+char BoardView::getCell(int row, int col) const
+{
+    if (row < 0 || row >= boardSize || col < 0 || col >= boardSize)
+        return ' ';
+    return cells[static_cast<size_t>(row * boardSize + col)];
+}
+
+void BoardView::clear()
+{
+    std::fill(cells.begin(), cells.end(), ' ');
+    updateAccessibleDescription();
+    update();
+}
+
+void BoardView::setInteractive(bool enabled)
+{
+    if (interactive == enabled)
+        return;
+    interactive = enabled;
+    update();
+}
+
+void BoardView::setTheme(const BoardTheme& boardTheme)
+{
+    theme = boardTheme;
+    tileRatio = 0.0;
+    update();
+}
+
+QRect BoardView::cellRect(int row, int col) const
+{
+    return QRect(col * cellSize, row * cellSize, cellSize, cellSize);
+}
+
+QPoint BoardView::cellAt(const QPoint& pos) const
+{
+    if (pos.x() < 0 || pos.y() < 0)
+        return QPoint(-1, -1);
+    int row = pos.y() / cellSize;
+    int col = pos.x() / cellSize;
+    if (row >= boardSize || col >= boardSize)
+        return QPoint(-1, -1);
+    return QPoint(row, col);
+}
+
+// Tiles are rebuilt only when the theme, cell size or screen pixel ratio
+// changes; painting a cell is then a lookup by state.
+const QPixmap& BoardView::tile(char mark)
+{
+    const qreal ratio = devicePixelRatioF();
+    if (ratio != tileRatio) {
+        AllocationScope allocations(AllocationTracker::Widgets);
+        QFont glyphFont = font();
+        glyphFont.setPixelSize(std::max(1, static_cast<int>(cellSize * theme.glyphScale)));
+        const QRect cell(0, 0, cellSize, cellSize);
+        for (int state = 0; state < BoardTheme::CellStateCount; ++state) {
+            QPixmap& pixmap = tiles[state];
+            pixmap = QPixmap(cell.size() * ratio);
+            pixmap.setDevicePixelRatio(ratio);
+            QPainter painter(&pixmap);
+            painter.fillRect(cell, theme.background[state]);
+            painter.setPen(theme.borderPen);
+            painter.drawRect(cell.adjusted(0, 0, -1, -1));
+            if (!theme.glyph[state].isEmpty()) {
+                painter.setRenderHint(QPainter::TextAntialiasing);
+                painter.setFont(glyphFont);
+                painter.setPen(theme.glyphPen);
+                painter.drawText(cell, Qt::AlignCenter, theme.glyph[state]);
+            }
+        }
+        tileRatio = ratio;
+    }
+    return tiles[BoardTheme::stateFor(mark)];
+}
+
+void BoardView::paintEvent(QPaintEvent* event)
+{
+    QPainter painter(this);
+    const QRect dirty = event->rect();
+    const int firstRow = std::max(dirty.top() / cellSize, 0);
+    const int lastRow = std::min(dirty.bottom() / cellSize, boardSize - 1);
+    const int firstCol = std::max(dirty.left() / cellSize, 0);
+    const int lastCol = std::min(dirty.right() / cellSize, boardSize - 1);
+    for (int row = firstRow; row <= lastRow; ++row)
+        for (int col = firstCol; col <= lastCol; ++col)
+            painter.drawPixmap(col * cellSize, row * cellSize, tile(getCell(row, col)));
+
+    if (!interactive) {
+        painter.fillRect(dirty, theme.disabledShade);
+    } else if (hasFocus()) {
+        painter.setPen(theme.focusPen);
+        painter.setBrush(Qt::NoBrush);
+        const int inset = theme.focusPen.width();
+        painter.drawRect(cellRect(cursorCell.x(), cursorCell.y()).adjusted(inset, inset, -inset - 1, -inset - 1));
+    }
+}
+
+// A click lands on release over the cell that was pressed, like a button.
+void BoardView::mousePressEvent(QMouseEvent* event)
+{
+    pressedCell = (interactive && event->button() == Qt::LeftButton) ? cellAt(event->pos()) : QPoint(-1, -1);
+    QWidget::mousePressEvent(event);
+}
+
+void BoardView::mouseReleaseEvent(QMouseEvent* event)
+{
+    qint64 releaseNs = ProbeEventBuffer::nowNs();
+    QPoint cell = cellAt(event->pos());
+    bool clicked = interactive && event->button() == Qt::LeftButton && cell.x() != -1 && cell == pressedCell;
+    pressedCell = QPoint(-1, -1);
+    if (clicked) {
+        clickNs = releaseNs;
+        moveCursor(cell.x(), cell.y());
+        emit cellClicked(cell.x(), cell.y());
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+void BoardView::keyPressEvent(QKeyEvent* event)
+{
+    switch (event->key()) {
+    case Qt::Key_Up:
+        moveCursor(cursorCell.x() - 1, cursorCell.y());
+        break;
+    case Qt::Key_Down:
+        moveCursor(cursorCell.x() + 1, cursorCell.y());
+        break;
+    case Qt::Key_Left:
+        moveCursor(cursorCell.x(), cursorCell.y() - 1);
+        break;
+    case Qt::Key_Right:
+        moveCursor(cursorCell.x(), cursorCell.y() + 1);
+        break;
+    case Qt::Key_Space:
+    case Qt::Key_Return:
+    case Qt::Key_Enter:
+        if (!interactive || event->isAutoRepeat())
+            break;
+        clickNs = ProbeEventBuffer::nowNs();
+        emit cellClicked(cursorCell.x(), cursorCell.y());
+        break;
+    default:
+        QWidget::keyPressEvent(event);
+        return;
+    }
+    event->accept();
+}
+
+void BoardView::focusInEvent(QFocusEvent* event)
+{
+    update(cellRect(cursorCell.x(), cursorCell.y()));
+    QWidget::focusInEvent(event);
+}
+
+void BoardView::focusOutEvent(QFocusEvent* event)
+{
+    update(cellRect(cursorCell.x(), cursorCell.y()));
+    QWidget::focusOutEvent(event);
+}
+
+// The cursor stops at the board's edges.
+void BoardView::moveCursor(int row, int col)
+{
+    QPoint next(qBound(0, row, boardSize - 1), qBound(0, col, boardSize - 1));
+    if (next == cursorCell)
+        return;
+    update(cellRect(cursorCell.x(), cursorCell.y()));
+    cursorCell = next;
+    update(cellRect(cursorCell.x(), cursorCell.y()));
+    updateAccessibleDescription();
+}
+
+// Screen readers see the board as one widget; its description follows
+// the cursor cell.
+void BoardView::updateAccessibleDescription()
+{
+    char mark = getCell(cursorCell.x(), cursorCell.y());
+    setAccessibleDescription(QString("Row %1, column %2: %3")
+                                 .arg(cursorCell.x() + 1)
+                                 .arg(cursorCell.y() + 1)
+                                 .arg(mark == ' ' ? QString("empty") : QString(QChar::fromLatin1(mark))));
+}
+
 // ------------------------------------------------------------------
 // GameBoard Implementation
 
 GameBoard::GameBoard(QWidget *parent, int mode)
     : QWidget(parent), currentPlayer('X'), gameActive(true), gameMode(mode), aiPerformanceMonitor("AI Decision Making")
 {
+    AllocationScope allocations(AllocationTracker::Widgets);
     mainLayout = new QGridLayout(this);
     mainLayout->setSpacing(0);
+    aiPerformanceMonitor.setRollingWindow(5 * 60 * 1000);
+    aiTimer = new QTimer(this);
+    aiTimer->setSingleShot(true);
+    aiTimer->setInterval(100);
+    connect(aiTimer, &QTimer::timeout, this, &GameBoard::aiMove);
     initializeBoard();
 }
 
 GameBoard::~GameBoard()
 {
-    for (auto& row : buttons) {
-        for (auto& button : row) {
-            if (button) {
-                delete button;
-            }
-        }
-        row.clear();
+    if (aiTimer) {
+        aiTimer->stop();
+        delete aiTimer;
+    }
+    if (boardView) {
+        delete boardView;
     }
-    buttons.clear();
     if (mainLayout) {
         delete mainLayout;
     }
@@ -320,18 +2553,10 @@ GameBoard::~GameBoard()
 void GameBoard::initializeBoard()
 {
     board.assign(3, std::vector<char>(3, ' '));
-    buttons.assign(3, std::vector<QPushButton*>(3, nullptr));
-    for (int row = 0; row < 3; ++row)
-    {
-        for (int col = 0; col < 3; ++col)
-        {
-            buttons[row][col] = new QPushButton(this);
-            buttons[row][col]->setFixedSize(80, 80);
-            buttons[row][col]->setStyleSheet("font: 24px;");
-            mainLayout->addWidget(buttons[row][col], row, col);
-            connect(buttons[row][col], &QPushButton::clicked, this, &GameBoard::onCellClicked);
-        }
-    }
+    boardView = new BoardView(3, this);
+    mainLayout->addWidget(boardView, 0, 0);
+    connect(boardView, &BoardView::cellClicked, this, &GameBoard::onCellClicked);
+    boardView->installEventFilter(this);
     resetBoard();
 }
 
@@ -339,15 +2564,22 @@ void GameBoard::resetBoard()
 {
     for (int row = 0; row < 3; ++row)
         for (int col = 0; col < 3; ++col)
-        {
             board[row][col] = ' ';
-            buttons[row][col]->setText("");
-            buttons[row][col]->setEnabled(true);
-            QString style = "QPushButton { background-color: #f0f0f0; border: 1px solid #ccc; }";
-            buttons[row][col]->setStyleSheet(style);
-        }
+    boardView->clear();
+    boardView->setInteractive(true);
+    aiTimer->stop();
     currentPlayer = 'X';
     gameActive = true;
+    moveClock.start();
+    lastMoveOffsetMs = 0;
+    lastMove = { -1, -1, ' ' };
+}
+
+// A pending AI move from the previous game is dropped by resetBoard.
+void GameBoard::configure(int mode)
+{
+    gameMode = mode;
+    resetBoard();
 }
 
 bool GameBoard::makeMove(int row, int col, char player)
@@ -357,6 +2589,10 @@ bool GameBoard::makeMove(int row, int col, char player)
     {
         board[row][col] = player;
         updateButtonText(row, col, player);
+
+        qint64 offsetMs = moveClock.elapsed();
+        lastMove = { row, col, player, offsetMs, double(offsetMs - lastMoveOffsetMs) };
+        lastMoveOffsetMs = offsetMs;
         return true;
     }
     return false;
@@ -405,60 +2641,43 @@ bool GameBoard::isEmpty(int row, int col) const
 
 void GameBoard::updateButtonText(int row, int col, char text)
 {
-    buttons[row][col]->setText(QString(QChar(text)));
-    buttons[row][col]->setEnabled(false);
-    QString style;
-    if (text == 'X')
-        style = "QPushButton { background-color: #87CEFA; border: 1px solid #ccc; font: 24px; }";
-    else
-        style = "QPushButton { background-color: #FFA07A; border: 1px solid #ccc; font: 24px; }";
-    buttons[row][col]->setStyleSheet(style);
+    boardView->setCell(row, col, text);
 }
 
 void GameBoard::disableBoard()
 {
-    for (int row = 0; row < 3; ++row)
-        for (int col = 0; col < 3; ++col)
-            buttons[row][col]->setEnabled(false);
+    boardView->setInteractive(false);
     gameActive = false;
 }
 
+// Occupied cells need no disabling: makeMove rejects them.
 void GameBoard::enableBoard()
 {
-    for (int row = 0; row < 3; ++row)
-        for (int col = 0; col < 3; ++col)
-            if (board[row][col] == ' ')
-                buttons[row][col]->setEnabled(true);
+    boardView->setInteractive(true);
     gameActive = true;
 }
 
-void GameBoard::onCellClicked()
+// Cells are found by BoardView's hit test, so dispatch costs the same on
+// any board size. Click-to-move latency runs from the mouse release until
+// the move is applied and every moveMade receiver has run.
+void GameBoard::onCellClicked(int row, int col)
 {
-    QPushButton* clickedButton = qobject_cast<QPushButton*>(sender());
-    if (!clickedButton || !gameActive)
-        return;
-
-    int row = -1, col = -1;
-    for (int i = 0; i < 3; ++i)
-    {
-        for (int j = 0; j < 3; ++j)
-        {
-            if (buttons[i][j] == clickedButton)
-            {
-                row = i;
-                col = j;
-                break;
-            }
-        }
-        if (row != -1)
-            break;
-    }
-    if (row == -1 || col == -1)
+    qint64 clickNs = sender() == boardView ? boardView->getClickNs() : ProbeEventBuffer::nowNs();
+    if (!gameActive)
         return;
 
     if (makeMove(row, col, currentPlayer))
     {
+        MainWindow::thinkTimeMonitor.addMeasurement(lastMove.thinkMs);
+        pendingPaintCell = QPoint(row, col);
+        pendingPaintClickNs = clickNs;
+
         emit moveMade(row, col, currentPlayer);
+        qint64 movedNs = ProbeEventBuffer::nowNs();
+#ifndef TICTACTOE_DISABLE_PROBES
+        ProbeEventBuffer::local().record("ui.clickToMove", clickNs, movedNs - clickNs);
+#endif
+        MainWindow::clickToMoveMonitor.addMeasurement((movedNs - clickNs) / 1000000.0);
         if (checkWinner(currentPlayer))
         {
             QString winnerName = (currentPlayer == 'X') ? "You" : "AI";
@@ -481,22 +2700,40 @@ void GameBoard::onCellClicked()
     }
 }
 
+// Click-to-paint latency: from the click handler until the board starts
+// a repaint that covers the clicked cell.
+bool GameBoard::eventFilter(QObject* watched, QEvent* event)
+{
+    if (event->type() == QEvent::Paint && watched == boardView && pendingPaintCell.x() != -1 &&
+        static_cast<QPaintEvent*>(event)->rect().intersects(boardView->cellRect(pendingPaintCell.x(), pendingPaintCell.y()))) {
+        qint64 nowNs = ProbeEventBuffer::nowNs();
+#ifndef TICTACTOE_DISABLE_PROBES
+        ProbeEventBuffer::local().record("ui.clickToPaint", pendingPaintClickNs, nowNs - pendingPaintClickNs);
+#endif
+        MainWindow::inputLatencyMonitor.addMeasurement((nowNs - pendingPaintClickNs) / 1000000.0);
+        pendingPaintCell = QPoint(-1, -1);
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
 void GameBoard::triggerAiMove()
 {
     if (!gameActive || currentPlayer != 'O' || gameMode != 2)
         return;
-    QTimer::singleShot(100, this, &GameBoard::aiMove);
+    aiTimer->start();
 }
 
 void GameBoard::aiMove()
 {
     if (!gameActive || currentPlayer != 'O' || gameMode != 2)
         return;
+    ScopedProbe probe("ai.move");
 
     QPoint bestMove = findBestMove();
     if (bestMove.x() != -1 && bestMove.y() != -1)
     {
         makeMove(bestMove.x(), bestMove.y(), currentPlayer);
+        lastMove.thinkMs = lastAiThinkMs;
         emit moveMade(bestMove.x(), bestMove.y(), currentPlayer);
         if (checkWinner(currentPlayer))
         {
@@ -556,7 +2793,8 @@ int GameBoard::minimax(std::vector<std::vector<char>> currentBoard, char player)
 }
 
 QPoint GameBoard::findBestMove() {
-    aiPerformanceMonitor.startMeasurement();
+    ScopedProbe probe("ai.findBestMove", &aiPerformanceMonitor);
+    AllocationScope allocations(AllocationTracker::AiSearch);
 
     int bestScore = -1000;
     QPoint bestMove = { -1, -1 };
@@ -576,204 +2814,744 @@ QPoint GameBoard::findBestMove() {
         }
     }
 
-    aiPerformanceMonitor.stopMeasurement();
-    return bestMove;
+    lastAiThinkMs = probe.stop();
+    MainWindow::aiPerformanceMonitor.addMeasurement(lastAiThinkMs);
+    return bestMove;
+}
+
+std::vector<QPoint> GameBoard::getAvailableMoves(const std::vector<std::vector<char>>& b)
+{
+    std::vector<QPoint> moves;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            if (b[i][j] == ' ') {
+                moves.push_back(QPoint(i, j));
+            }
+        }
+    }
+    return moves;
+}
+
+// ------------------------------------------------------------------
+// GamePersister Implementation
+
+GamePersister::GamePersister(QObject* parent)
+    : QObject(parent), pending(0)
+{
+    thread.setObjectName("GamePersister");
+    worker = new QObject();
+    worker->moveToThread(&thread);
+    thread.start();
+}
+
+GamePersister::~GamePersister()
+{
+    // Queued behind any outstanding jobs, so every submitted game is saved
+    // before the thread exits and its database connection is released.
+    QMetaObject::invokeMethod(worker, [] { QThread::currentThread()->quit(); }, Qt::QueuedConnection);
+    thread.wait();
+    delete worker;
+}
+
+void GamePersister::submit(const Job& job)
+{
+    ++pending;
+    QMetaObject::invokeMethod(worker, [this, job] { run(job); }, Qt::QueuedConnection);
+}
+
+void GamePersister::run(const Job& job)
+{
+    ScopedProbe probe("game.persist");
+    bool ok = true;
+    if (job.database) {
+        if (!job.username.isEmpty())
+            ok = job.database->saveGameRecord(job.username, job.record);
+        if (job.saveMetrics)
+            ok = job.database->saveGameMetrics(job.metrics, job.context) && ok;
+    }
+    if (job.exporter)
+        job.exporter->appendSnapshot(job.monitors, job.metrics);
+    if (!ok)
+        qDebug() << "Error saving game for" << job.username;
+    --pending;
+    emit saved(ok);
+}
+
+// ------------------------------------------------------------------
+// GameDialog Implementation
+
+GameDialog::GameDialog(QWidget *parent)
+    : QDialog(parent), gameBoard(nullptr), gameMode(0)
+{
+    AllocationScope allocations(AllocationTracker::Widgets);
+    this->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+    mainLayout = new QGridLayout(this);
+    verticalLayout = new QVBoxLayout();
+    buttonLayout = new QHBoxLayout();
+
+    pvpButton = new QPushButton("PvP (Two Players)", this);
+    pvaiButton = new QPushButton("PvAI (Play against AI)", this);
+    replayButton = new QPushButton("Replay Game", this);
+
+    // The picker's list is built on first use and then only when the
+    // history changes; its popup pages games in as it scrolls.
+    replayListModel = new ReplayListModel(this);
+    replayRevision = 0;
+    comboBoxGameList = new QComboBox(this);
+    comboBoxGameList->setModel(replayListModel);
+    connect(comboBoxGameList, QOverload<int>::of(&QComboBox::activated),
+            this, &GameDialog::onComboBoxActivated);
+    replaySearchEdit = new QLineEdit(this);
+    replaySearchEdit->setPlaceholderText("Search games: mode, winner, yyyy-MM-dd or opponent");
+    replaySearchEdit->setClearButtonEnabled(true);
+    replaySearchTimer = new QTimer(this);
+    replaySearchTimer->setSingleShot(true);
+    replaySearchTimer->setInterval(200);
+    connect(replaySearchEdit, &QLineEdit::textChanged, replaySearchTimer, QOverload<>::of(&QTimer::start));
+    connect(replaySearchTimer, &QTimer::timeout, this, &GameDialog::onReplaySearchChanged);
+
+    // Results are shown in place rather than in message boxes, so the
+    // next game can start straight away; the panel keeps its space while
+    // hidden and joins the layout with the board.
+    resultsPanel = new QFrame(this);
+    resultsPanel->setFrameShape(QFrame::StyledPanel);
+    QSizePolicy resultsPolicy = resultsPanel->sizePolicy();
+    resultsPolicy.setRetainSizeWhenHidden(true);
+    resultsPanel->setSizePolicy(resultsPolicy);
+    resultsLabel = new QLabel(resultsPanel);
+    detailsButton = new QPushButton("Details", resultsPanel);
+    QHBoxLayout* resultsLayout = new QHBoxLayout(resultsPanel);
+    resultsLayout->addWidget(resultsLabel, 1);
+    resultsLayout->addWidget(detailsButton);
+    resultsPanel->hide();
+    connect(detailsButton, &QPushButton::clicked, this, &GameDialog::on_detailsButton_clicked);
+
+    persister = new GamePersister(this);
+    connect(persister, &GamePersister::saved, this, &GameDialog::onGameSaved);
+
+    verticalLayout->addWidget(replaySearchEdit);
+    verticalLayout->addWidget(comboBoxGameList);
+    verticalLayout->addWidget(replayButton);
+    verticalLayout->addLayout(buttonLayout);
+    buttonLayout->addWidget(pvpButton);
+    buttonLayout->addWidget(pvaiButton);
+    mainLayout->addLayout(verticalLayout, 0, 0);
+
+    connect(pvpButton, &QPushButton::clicked, this, &GameDialog::on_pvpButton_clicked);
+    connect(pvaiButton, &QPushButton::clicked, this, &GameDialog::on_pvaiButton_clicked);
+    connect(replayButton, &QPushButton::clicked, this, &GameDialog::on_replayButton_clicked);
+
+    player1Name = "Player 1";
+    player2Name = "Player 2";
+}
+
+GameDialog::~GameDialog()
+{
+    // Finishes any saves still queued before the board and lists go.
+    if (persister) delete persister;
+    if (gameBoard) {
+        delete gameBoard;
+        gameBoard = nullptr;
+    }
+    if (pvpButton) delete pvpButton;
+    if (pvaiButton) delete pvaiButton;
+    if (replayButton) delete replayButton;
+    if (comboBoxGameList) delete comboBoxGameList;
+    if (replaySearchEdit) delete replaySearchEdit;
+    if (replayListModel) delete replayListModel;
+    if (resultsPanel) delete resultsPanel;
+    if (buttonLayout) delete buttonLayout;
+    if (verticalLayout) delete verticalLayout;
+    if (mainLayout) delete mainLayout;
+}
+
+void GameDialog::on_pvpButton_clicked()
+{
+    player1Name = QInputDialog::getText(this, "Player 1 Name", "Enter name for Player 1:", QLineEdit::Normal, "Player 1");
+    if (player1Name.isEmpty())
+        player1Name = "Player 1";
+    player2Name = QInputDialog::getText(this, "Player 2 Name", "Enter name for Player 2:", QLineEdit::Normal, "Player 2");
+    if (player2Name.isEmpty())
+        player2Name = "Player 2";
+    startGame(1);
+}
+
+void GameDialog::on_pvaiButton_clicked()
+{
+    player1Name = QInputDialog::getText(this, "Player Name", "Enter your name:", QLineEdit::Normal, "Player");
+    if (player1Name.isEmpty())
+        player1Name = "Player";
+    startGame(2);
+}
+
+void GameDialog::startGame(int mode)
+{
+    ScopedProbe probe("game.start");
+    gameMode = mode;
+    // The board is built once and reset in place for later games; only
+    // the first game changes the dialog's layout.
+    if (!gameBoard) {
+        gameBoard = new GameBoard(this, gameMode);
+        connect(gameBoard, &GameBoard::moveMade, this, &GameDialog::recordMove);
+        // Queued, so the move that ended the game returns to the event loop
+        // before the result is handled.
+        connect(gameBoard, &GameBoard::gameOver, this, &GameDialog::onGameOver, Qt::QueuedConnection);
+        mainLayout->addWidget(gameBoard, 1, 0);
+        mainLayout->addWidget(resultsPanel, 2, 0);
+        gameBoard->show();
+        this->adjustSize();
+    } else {
+        gameBoard->configure(gameMode);
+    }
+    resultsPanel->hide();
+    moves.clear();
+
+    MainWindow::gameMetrics.startGame();
+    gameClock.start();
+}
+
+void GameDialog::recordMove(int row, int col, char player)
+{
+    Move m;
+    m.row = row;
+    m.col = col;
+    m.player = player;
+    GameBoard* board = qobject_cast<GameBoard*>(sender());
+    if (board && board->getLastMove().row == row && board->getLastMove().col == col) {
+        m.offsetMs = board->getLastMove().offsetMs;
+        m.thinkMs = board->getLastMove().thinkMs;
+    }
+    if (moves.empty()) {
+        resultsPanel->hide();
+        // After a finished game the board is reset in place, so the next
+        // game is timed from its first move rather than from the result.
+        if (!gameClock.isValid()) {
+            MainWindow::gameMetrics.startGame();
+            gameClock.start();
+        }
+    }
+    moves.push_back(m);
+}
+
+void GameDialog::onGameOver(const QString& winner)
+{
+#ifndef TICTACTOE_DISABLE_PROBES
+    // One span per game, from its start to the result.
+    if (gameClock.isValid()) {
+        qint64 playedNs = gameClock.nsecsElapsed();
+        ProbeEventBuffer::local().record("game.play", ProbeEventBuffer::nowNs() - playedNs, playedNs);
+    }
+#endif
+    ScopedProbe probe("game.over");
+    QString message = (winner == "Draw") ? "It's a draw!" : winner + " wins!";
+
+    GameContext context;
+    context.mode = (gameMode == 1) ? "PvP" : "PvAI";
+    context.aiStrategy = (gameMode == 2) ? "minimax" : "none";
+    context.boardSize = 3;
+    context.user = MainWindow::currentUser;
+    bool metricsRecorded = MainWindow::gameMetrics.endGame(winner, context);
+
+    GameRecord record;
+    record.mode = (gameMode == 1) ? "PvP" : "PvAI";
+    record.winner = winner.toStdString();
+    record.moves = moves;
+    record.timestamp = DatabaseManager::formatTimestamp(QDateTime::currentDateTimeUtc());
+    record.durationMs = gameClock.isValid() ? gameClock.nsecsElapsed() / 1000000.0 : 0.0;
+    record.opponent = (gameMode == 1) ? player2Name : QString("AI");
+
+    {
+        AllocationScope allocations(AllocationTracker::GameHistory);
+        MainWindow::gameHistory.push_back(record);
+    }
+
+    // The database writes and the metrics snapshot run on the persister's
+    // thread; only copies of the shared state are taken here.
+    GamePersister::Job job;
+    job.database = MainWindow::dbManager;
+    job.username = MainWindow::currentUser;
+    job.record = record;
+    job.saveMetrics = metricsRecorded && MainWindow::dbManager;
+    job.metrics = MainWindow::gameMetrics;
+    job.context = context;
+    if (MainWindow::metricsExporter) {
+        job.exporter = MainWindow::metricsExporter;
+        job.monitors = MainWindow::snapshotMonitors();
+    }
+    persister->submit(job);
+
+    resultsLabel->setText(QString("%1\n%2, %3 moves in %4 s")
+                              .arg(message, context.mode)
+                              .arg(static_cast<int>(moves.size()))
+                              .arg(record.durationMs / 1000.0, 0, 'f', 1));
+    resultsPanel->show();
+
+    if (gameBoard) {
+        gameBoard->resetBoard();
+        gameBoard->enableBoard();
+    }
+    moves.clear();
+    gameClock.invalidate();
+
+    probe.stop();
+    TraceRecorder::collect();
+}
+
+void GameDialog::onGameSaved(bool ok)
+{
+    // The database list may now be missing a game; rebuild it on next use.
+    replayUser.clear();
+    if (!ok)
+        resultsLabel->setText(resultsLabel->text() + "\nThis game could not be saved.");
+}
+
+void GameDialog::on_detailsButton_clicked()
+{
+    QMessageBox* box = new QMessageBox(QMessageBox::Information, "Performance Metrics",
+                                       performanceReport(), QMessageBox::Ok, this);
+    box->setAttribute(Qt::WA_DeleteOnClose);
+    box->setModal(false);
+    box->show();
+}
+
+// Built only when asked for, as percentiles and reports walk every sample.
+QString GameDialog::performanceReport() const
+{
+    DatabaseManager* database = MainWindow::dbManager;
+    double dbAvg = database ? database->getPerformanceMonitor().getAverageTime() : 0.0;
+    double loginAvg = MainWindow::loginPerformanceMonitor.getAverageTime();
+    double aiAvg = gameBoard ? gameBoard->getAiPerformanceMonitor().getAverageTime() : 0.0;
+    double gameAvg = MainWindow::gameMetrics.getAverageGameDuration();
+
+    ResourceUsage usage = PerformanceMonitor::sampleResourceUsage();
+
+    QString perfMsg = QString(
+                          "Database Operations Avg: %1 ms\n"
+                          "Login Operations Avg: %2 ms\n"
+                          "AI Decision Making Avg: %3 ms\n"
+                          "Game Duration Avg: %4 ms\n"
+                          "Memory Usage: %5 MB (peak %6 MB)\n"
+                          "CPU Usage: %7% system, %8% process"
+                          )
+                          .arg(dbAvg, 0, 'f', 2)
+                          .arg(loginAvg, 0, 'f', 2)
+                          .arg(aiAvg, 0, 'f', 2)
+                          .arg(gameAvg, 0, 'f', 2)
+                          .arg(usage.rssMB, 0, 'f', 2)
+                          .arg(usage.peakRssMB, 0, 'f', 2)
+                          .arg(usage.systemCpuPercent, 0, 'f', 2)
+                          .arg(usage.processCpuPercent, 0, 'f', 2);
+    perfMsg += QString("\nContext Switches: %1 voluntary, %2 involuntary\n"
+                       "Page Faults: %3 minor, %4 major")
+                   .arg(usage.voluntaryContextSwitches)
+                   .arg(usage.involuntaryContextSwitches)
+                   .arg(usage.minorPageFaults)
+                   .arg(usage.majorPageFaults);
+
+    PerformanceMonitor aiMonitor = gameBoard ? gameBoard->getAiPerformanceMonitor() : PerformanceMonitor();
+    perfMsg += QString("\nAI Decision Making p50/p99/max: %1 / %2 / %3 ms (last 5 min p99: %4 ms)")
+                   .arg(aiMonitor.getPercentile(50), 0, 'f', 2)
+                   .arg(aiMonitor.getPercentile(99), 0, 'f', 2)
+                   .arg(aiMonitor.getMaxTime(), 0, 'f', 2)
+                   .arg(aiMonitor.getWindowPercentile(99), 0, 'f', 2);
+
+    perfMsg += QString("\nHuman Think Time p50/p90: %1 / %2 ms\n"
+                       "Click to Move p50/p99: %3 / %4 ms\n"
+                       "Click to Paint p50/p99: %5 / %6 ms")
+                   .arg(MainWindow::thinkTimeMonitor.getPercentile(50), 0, 'f', 0)
+                   .arg(MainWindow::thinkTimeMonitor.getPercentile(90), 0, 'f', 0)
+                   .arg(MainWindow::clickToMoveMonitor.getPercentile(50), 0, 'f', 2)
+                   .arg(MainWindow::clickToMoveMonitor.getPercentile(99), 0, 'f', 2)
+                   .arg(MainWindow::inputLatencyMonitor.getPercentile(50), 0, 'f', 2)
+                   .arg(MainWindow::inputLatencyMonitor.getPercentile(99), 0, 'f', 2);
+
+    QString dbReport = database ? database->getProfileReport() : QString();
+    if (!dbReport.isEmpty())
+        perfMsg += "\n\nDatabase Operations:\n" + dbReport;
+
+    QString allocationReport = PerformanceMonitor::getAllocationReport();
+    if (!allocationReport.isEmpty())
+        perfMsg += "\n\nHeap by Subsystem:\n" + allocationReport;
+
+    return perfMsg;
+}
+
+void GameDialog::on_replayButton_clicked()
+{
+    refreshReplayList();
+    GameHistoryModel* games = replayListModel->getSource();
+    if (games->totalRowCount() == 0 && games->getFilter().isEmpty())
+    {
+        QMessageBox::information(this, "Replay", "No games have been played yet.");
+        return;
+    }
+    comboBoxGameList->setCurrentIndex(0);
+    comboBoxGameList->showPopup();
+}
+
+// Lists the signed-in user's games straight from the database, or the
+// in-memory history otherwise; either way only the first page is loaded.
+void GameDialog::refreshReplayList()
+{
+    QString user = MainWindow::dbManager ? MainWindow::currentUser : QString();
+    quint64 revision = MainWindow::gameHistory.getRevision();
+    if (revision == replayRevision && user == replayUser)
+        return;
+    replayRevision = revision;
+    replayUser = user;
+
+    // Replacing the source drops the snapshot of the older revision. Only
+    // the no-database fallback shares one with gameHistory, and that
+    // holds just this session's games, so appends there copy little.
+    GameHistoryModel* games = replayListModel->getSource();
+    if (!user.isEmpty())
+        games->setDatabaseSource(MainWindow::dbManager, user);
+    else
+        games->setRecords(MainWindow::gameHistory.snapshot());
+}
+
+void GameDialog::onReplaySearchChanged()
+{
+    replaySearchTimer->stop();
+    refreshReplayList();
+    replayListModel->getSource()->setFilter(HistoryFilter::fromSearchText(replaySearchEdit->text()));
+}
+
+void GameDialog::onComboBoxActivated(int index)
+{
+    GameHistoryModel* games = replayListModel->getSource();
+    if (index <= 0 || index > games->rowCount())
+    {
+        QMessageBox::warning(this, "Replay", "Please select a valid game number.");
+        return;
+    }
+    const GameRecord &record = games->recordAt(index - 1);
+    // Database pages carry no moves; fetch just this game's.
+    std::vector<Move> replayMoves = record.moves;
+    if (replayMoves.empty() && record.id > 0 && MainWindow::dbManager)
+        replayMoves = MainWindow::dbManager->loadGameMoves(record.id);
+    if (replayMoves.empty())
+    {
+        QMessageBox::warning(this, "Replay", "No move data available for this game.");
+        return;
+    }
+    if (ReplayEngine::boardSizeFor(replayMoves) > ReplayEngine::MaxBoardSize)
+    {
+        QMessageBox::warning(this, "Replay", "This game's moves do not fit a replayable board.");
+        return;
+    }
+    ReplayDialog* replayDialog = new ReplayDialog(replayMoves, this);
+    replayDialog->exec();
+    delete replayDialog;
+}
+
+// ------------------------------------------------------------------
+// HistoryFilter Implementation
+
+bool HistoryFilter::isEmpty() const
+{
+    return mode.empty() && winner.empty() && opponent.isEmpty() && !from.isValid() && !to.isValid();
+}
+
+bool HistoryFilter::matches(const GameRecord& record) const
+{
+    return (mode.empty() || record.mode == mode)
+        && (winner.empty() || record.winner == winner)
+        && (opponent.isEmpty() || record.opponent.startsWith(opponent, Qt::CaseInsensitive))
+        && (!from.isValid() || record.timestamp >= DatabaseManager::formatTimestamp(from))
+        && (!to.isValid() || record.timestamp < DatabaseManager::formatTimestamp(to));
+}
+
+HistoryFilter HistoryFilter::fromSearchText(const QString& text)
+{
+    HistoryFilter filter;
+    const QString query = text.trimmed();
+    if (query.isEmpty())
+        return filter;
+
+    for (const char* mode : { "PvP", "PvAI" }) {
+        if (query.compare(mode, Qt::CaseInsensitive) == 0) {
+            filter.mode = mode;
+            return filter;
+        }
+    }
+    for (const char* winner : { "You", "AI", "Player 1", "Player 2", "Draw" }) {
+        if (query.compare(winner, Qt::CaseInsensitive) == 0) {
+            filter.winner = winner;
+            return filter;
+        }
+    }
+    // Dates are UTC days, as timestamps are stored and shown.
+    QDate day = QDate::fromString(query, "yyyy-MM-dd");
+    if (day.isValid()) {
+        filter.from = QDateTime(day, QTime(0, 0), Qt::UTC);
+        filter.to = filter.from.addDays(1);
+        return filter;
+    }
+    filter.opponent = query;
+    return filter;
+}
+
+// ------------------------------------------------------------------
+// GameHistoryStore Implementation
+
+GameHistoryStore::GameHistoryStore()
+    : records(std::make_shared<std::vector<GameRecord>>()), revision(0)
+{
+}
+
+GameHistoryStore& GameHistoryStore::operator=(std::vector<GameRecord> history)
+{
+    records = std::make_shared<std::vector<GameRecord>>(std::move(history));
+    ++revision;
+    return *this;
+}
+
+void GameHistoryStore::push_back(const GameRecord& record)
+{
+    detach().push_back(record);
+    ++revision;
+}
+
+void GameHistoryStore::clear()
+{
+    ++revision;
+    // Readers keep the old records; there is nothing to copy.
+    if (records.use_count() > 1)
+        records = std::make_shared<std::vector<GameRecord>>();
+    else
+        records->clear();
 }
 
-std::vector<QPoint> GameBoard::getAvailableMoves(const std::vector<std::vector<char>>& b)
+std::vector<GameRecord>& GameHistoryStore::detach()
 {
-    std::vector<QPoint> moves;
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            if (b[i][j] == ' ') {
-                moves.push_back(QPoint(i, j));
-            }
-        }
-    }
-    return moves;
+    if (records.use_count() > 1)
+        records = std::make_shared<std::vector<GameRecord>>(*records);
+    return *records;
 }
 
 // ------------------------------------------------------------------
-// GameDialog Implementation
+// GameHistoryModel Implementation
 
-GameDialog::GameDialog(QWidget *parent)
-    : QDialog(parent), gameBoard(nullptr), gameMode(0)
+GameHistoryModel::GameHistoryModel(QObject* parent)
+    : QAbstractTableModel(parent), database(nullptr), loadedRows(0), totalRows(0),
+      sortColumn(PlayedColumn), sortOrder(Qt::DescendingOrder)
 {
-    this->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
-    mainLayout = new QGridLayout(this);
-    verticalLayout = new QVBoxLayout();
-    buttonLayout = new QHBoxLayout();
+}
 
-    pvpButton = new QPushButton("PvP (Two Players)", this);
-    pvaiButton = new QPushButton("PvAI (Play against AI)", this);
-    replayButton = new QPushButton("Replay Game", this);
+void GameHistoryModel::setDatabaseSource(DatabaseManager* manager, const QString& user)
+{
+    database = manager;
+    username = user;
+    records.reset();
+    order.clear();
+    reload();
+}
 
-    comboBoxGameList = new QComboBox(this);
-    comboBoxGameList->addItem("Select a game...");
-    connect(comboBoxGameList, QOverload<int>::of(&QComboBox::activated),
-            this, &GameDialog::onComboBoxActivated);
+void GameHistoryModel::setRecords(const GameHistoryStore::Snapshot& history)
+{
+    database = nullptr;
+    username.clear();
+    records = history;
+    reload();
+}
 
-    verticalLayout->addWidget(comboBoxGameList);
-    verticalLayout->addWidget(replayButton);
-    verticalLayout->addLayout(buttonLayout);
-    buttonLayout->addWidget(pvpButton);
-    buttonLayout->addWidget(pvaiButton);
-    mainLayout->addLayout(verticalLayout, 0, 0);
+void GameHistoryModel::setFilter(const HistoryFilter& historyFilter)
+{
+    filter = historyFilter;
+    reload();
+}
 
-    connect(pvpButton, &QPushButton::clicked, this, &GameDialog::on_pvpButton_clicked);
-    connect(pvaiButton, &QPushButton::clicked, this, &GameDialog::on_pvaiButton_clicked);
-    connect(replayButton, &QPushButton::clicked, this, &GameDialog::on_replayButton_clicked);
+int GameHistoryModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : loadedRows;
+}
 
-    player1Name = "Player 1";
-    player2Name = "Player 2";
+int GameHistoryModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
 }
 
-GameDialog::~GameDialog()
+QVariant GameHistoryModel::data(const QModelIndex& index, int role) const
 {
-    if (gameBoard) {
-        delete gameBoard;
-        gameBoard = nullptr;
+    if (!index.isValid() || index.row() >= loadedRows || role != Qt::DisplayRole)
+        return QVariant();
+    const GameRecord& record = recordAt(index.row());
+    switch (index.column()) {
+    case ModeColumn:
+        return QString::fromStdString(record.mode);
+    case OpponentColumn:
+        return record.opponent;
+    case WinnerColumn:
+        return QString::fromStdString(record.winner);
+    case PlayedColumn:
+        return record.timestamp;
+    default:
+        return QVariant();
     }
-    if (pvpButton) delete pvpButton;
-    if (pvaiButton) delete pvaiButton;
-    if (replayButton) delete replayButton;
-    if (comboBoxGameList) delete comboBoxGameList;
-    if (buttonLayout) delete buttonLayout;
-    if (verticalLayout) delete verticalLayout;
-    if (mainLayout) delete mainLayout;
 }
 
-void GameDialog::on_pvpButton_clicked()
+QVariant GameHistoryModel::headerData(int section, Qt::Orientation orientation, int role) const
 {
-    player1Name = QInputDialog::getText(this, "Player 1 Name", "Enter name for Player 1:", QLineEdit::Normal, "Player 1");
-    if (player1Name.isEmpty())
-        player1Name = "Player 1";
-    player2Name = QInputDialog::getText(this, "Player 2 Name", "Enter name for Player 2:", QLineEdit::Normal, "Player 2");
-    if (player2Name.isEmpty())
-        player2Name = "Player 2";
-    startGame(1);
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QAbstractTableModel::headerData(section, orientation, role);
+    static const char* const titles[] = { "Mode", "Opponent", "Winner", "Played" };
+    return section >= 0 && section < ColumnCount ? QString(titles[section]) : QVariant();
 }
 
-void GameDialog::on_pvaiButton_clicked()
+bool GameHistoryModel::canFetchMore(const QModelIndex& parent) const
 {
-    player1Name = QInputDialog::getText(this, "Player Name", "Enter your name:", QLineEdit::Normal, "Player");
-    if (player1Name.isEmpty())
-        player1Name = "Player";
-    startGame(2);
+    return !parent.isValid() && loadedRows < totalRows;
 }
 
-void GameDialog::startGame(int mode)
+void GameHistoryModel::fetchMore(const QModelIndex& parent)
 {
-    gameMode = mode;
-    if (gameBoard) {
-        delete gameBoard;
+    if (!canFetchMore(parent))
+        return;
+
+    if (!database) {
+        int count = std::min(static_cast<int>(PageSize), totalRows - loadedRows);
+        beginInsertRows(QModelIndex(), loadedRows, loadedRows + count - 1);
+        loadedRows += count;
+        endInsertRows();
+        return;
     }
-    gameBoard = new GameBoard(this, gameMode);
-    connect(gameBoard, &GameBoard::moveMade, this, &GameDialog::recordMove);
-    connect(gameBoard, &GameBoard::gameOver, this, &GameDialog::onGameOver);
-    mainLayout->addWidget(gameBoard, 1, 0);
-    gameBoard->show();
-    moves.clear();
 
-    MainWindow::gameMetrics.startGame();
+    static const DatabaseManager::HistorySortColumn databaseColumns[] = {
+        DatabaseManager::SortByMode, DatabaseManager::SortByOpponent,
+        DatabaseManager::SortByWinner, DatabaseManager::SortByTimestamp
+    };
+    AllocationScope allocations(AllocationTracker::GameHistory);
+    std::vector<GameRecord> page = database->loadGameHistoryPage(username, filter, databaseColumns[sortColumn], sortOrder,
+                                                                 PageSize, rows.empty() ? nullptr : &rows.back());
+    // A short page means rows were deleted since counting; stop here.
+    if (static_cast<int>(page.size()) < PageSize)
+        totalRows = loadedRows + static_cast<int>(page.size());
+    if (page.empty())
+        return;
 
-    this->adjustSize();
+    beginInsertRows(QModelIndex(), loadedRows, loadedRows + static_cast<int>(page.size()) - 1);
+    rows.insert(rows.end(), std::make_move_iterator(page.begin()), std::make_move_iterator(page.end()));
+    loadedRows = static_cast<int>(rows.size());
+    endInsertRows();
 }
 
-void GameDialog::recordMove(int row, int col, char player)
+void GameHistoryModel::sort(int column, Qt::SortOrder order)
 {
-    Move m;
-    m.row = row;
-    m.col = col;
-    m.player = player;
-    moves.push_back(m);
+    if (column < 0 || column >= ColumnCount)
+        return;
+    sortColumn = static_cast<Column>(column);
+    sortOrder = order;
+    reload();
 }
 
-void GameDialog::onGameOver(const QString& winner)
+// Drops the loaded rows and starts again from the first page in the
+// current order. In-memory records are filtered and sorted here by index,
+// ties broken by when they were played; the records themselves are shared
+// with the store, never copied.
+void GameHistoryModel::reload()
 {
-    QString message = (winner == "Draw") ? "It's a draw!" : winner + " wins!";
-    QMessageBox::information(this, "Game Over", message);
-    MainWindow::gameMetrics.endGame(winner);
-
-    MainWindow::gameMetrics.endGame(winner);
-
-    // Now print all metrics
-    double dbAvg = MainWindow::dbManager->getPerformanceMonitor().getAverageTime();
-    double loginAvg = MainWindow::loginPerformanceMonitor.getAverageTime();
-    double aiAvg = gameBoard->getAiPerformanceMonitor().getAverageTime();
-    double gameAvg = MainWindow::gameMetrics.getAverageGameDuration();
+    beginResetModel();
+    loadedRows = 0;
+    rows.clear();
+    order.clear();
+    if (database) {
+        totalRows = database->countGameHistory(username, filter);
+    } else if (records) {
+        const std::vector<GameRecord>& history = *records;
+        AllocationScope allocations(AllocationTracker::GameHistory);
+        order.reserve(history.size());
+        for (size_t i = 0; i < history.size(); ++i) {
+            if (filter.matches(history[i]))
+                order.push_back(static_cast<int>(i));
+        }
+        auto compare = [&](int a, int b) {
+            switch (sortColumn) {
+            case ModeColumn:
+                return history[a].mode.compare(history[b].mode);
+            case OpponentColumn:
+                return QString::compare(history[a].opponent, history[b].opponent, Qt::CaseInsensitive);
+            case WinnerColumn:
+                return history[a].winner.compare(history[b].winner);
+            default:
+                return 0;
+            }
+        };
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            int result = compare(a, b);
+            if (result == 0)
+                result = a < b ? -1 : (a > b ? 1 : 0);
+            return sortOrder == Qt::AscendingOrder ? result < 0 : result > 0;
+        });
+        totalRows = static_cast<int>(order.size());
+    } else {
+        totalRows = 0;
+    }
+    endResetModel();
+    fetchMore(QModelIndex());
+}
 
-    double memMB = PerformanceMonitor::getCurrentMemoryUsageMB();
-    double cpuPercent = PerformanceMonitor::getCPUUsagePercent();
+// ------------------------------------------------------------------
+// ReplayListModel Implementation
 
-    QString perfMsg = QString(
-                          "Database Operations Avg: %1 ms\n"
-                          "Login Operations Avg: %2 ms\n"
-                          "AI Decision Making Avg: %3 ms\n"
-                          "Game Duration Avg: %4 ms\n"
-                          "Memory Usage: %5 MB\n"
-                          "CPU Usage: %6%%"
-                          )
-                          .arg(dbAvg, 0, 'f', 2)
-                          .arg(loginAvg, 0, 'f', 2)
-                          .arg(aiAvg, 0, 'f', 2)
-                          .arg(gameAvg, 0, 'f', 2)
-                          .arg(memMB, 0, 'f', 2)
-                          .arg(cpuPercent, 0, 'f', 2);
+ReplayListModel::ReplayListModel(QObject* parent)
+    : QAbstractListModel(parent), source(new GameHistoryModel(this))
+{
+    connect(source, &QAbstractItemModel::modelAboutToBeReset, this, &ReplayListModel::onSourceAboutToBeReset);
+    connect(source, &QAbstractItemModel::modelReset, this, &ReplayListModel::onSourceReset);
+    connect(source, &QAbstractItemModel::rowsAboutToBeInserted, this, &ReplayListModel::onSourceRowsAboutToBeInserted);
+    connect(source, &QAbstractItemModel::rowsInserted, this, &ReplayListModel::onSourceRowsInserted);
+}
 
-    QMessageBox::information(this, "Performance Metrics", perfMsg);
+int ReplayListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : source->rowCount() + 1;
+}
 
+QVariant ReplayListModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || role != Qt::DisplayRole)
+        return QVariant();
+    if (index.row() == 0)
+        return QString("Select a game...");
+    const GameRecord& record = source->recordAt(index.row() - 1);
+    QString text = QString("%1 - %2").arg(record.timestamp, QString::fromStdString(record.mode));
+    if (!record.opponent.isEmpty())
+        text += QString(" vs %1").arg(record.opponent);
+    return text + QString(" - %1").arg(QString::fromStdString(record.winner));
+}
 
-    GameRecord record;
-    record.mode = (gameMode == 1) ? "PvP" : "PvAI";
-    record.winner = winner.toStdString();
-    record.moves = moves;
-    record.timestamp = QDateTime::currentDateTime().toString();
+bool ReplayListModel::canFetchMore(const QModelIndex& parent) const
+{
+    return !parent.isValid() && source->canFetchMore(QModelIndex());
+}
 
-    MainWindow::gameHistory.push_back(record);
-    MainWindow::saveGameHistory();
+void ReplayListModel::fetchMore(const QModelIndex& parent)
+{
+    if (!parent.isValid())
+        source->fetchMore(QModelIndex());
+}
 
-    MainWindow::gameMetrics.endGame(winner);
+void ReplayListModel::onSourceAboutToBeReset()
+{
+    beginResetModel();
+}
 
-    gameBoard->resetBoard();
-    gameBoard->enableBoard();
-    moves.clear();
+void ReplayListModel::onSourceReset()
+{
+    endResetModel();
 }
 
-void GameDialog::on_replayButton_clicked()
+// Source rows sit one below the placeholder.
+void ReplayListModel::onSourceRowsAboutToBeInserted(const QModelIndex& parent, int first, int last)
 {
-    comboBoxGameList->clear();
-    if (MainWindow::gameHistory.empty())
-    {
-        QMessageBox::information(this, "Replay", "No games have been played yet.");
-        return;
-    }
-    comboBoxGameList->addItem("Select a game...");
-    for (size_t i = 0; i < MainWindow::gameHistory.size(); ++i)
-    {
-        QString itemText = QString("Game %1").arg(static_cast<int>(i + 1));
-        comboBoxGameList->addItem(itemText);
-    }
-    comboBoxGameList->showPopup();
+    Q_UNUSED(parent);
+    beginInsertRows(QModelIndex(), first + 1, last + 1);
 }
 
-void GameDialog::onComboBoxActivated(int index)
+void ReplayListModel::onSourceRowsInserted()
 {
-    if (index <= 0 || index > static_cast<int>(MainWindow::gameHistory.size()))
-    {
-        QMessageBox::warning(this, "Replay", "Please select a valid game number.");
-        return;
-    }
-    int selectedGameIndex = index - 1;
-    const GameRecord &record = MainWindow::gameHistory[static_cast<size_t>(selectedGameIndex)];
-    if (record.moves.empty())
-    {
-        QMessageBox::warning(this, "Replay", "No move data available for this game.");
-        return;
-    }
-    ReplayDialog* replayDialog = new ReplayDialog(record.moves, this);
-    replayDialog->exec();
-    delete replayDialog;
+    endInsertRows();
 }
 
 // ------------------------------------------------------------------
@@ -782,56 +3560,125 @@ void GameDialog::onComboBoxActivated(int index)
 HistoryDialog::HistoryDialog(QWidget *parent)
     : QDialog(parent)
 {
+    AllocationScope allocations(AllocationTracker::Widgets);
     this->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
     setWindowFlags(windowFlags() & ~Qt::WindowMaximizeButtonHint & ~Qt::WindowMinimizeButtonHint);
     mainLayout = new QVBoxLayout(this);
-    historyTextEdit = new QTextEdit(this);
-    historyTextEdit->setReadOnly(true);
-    historyTextEdit->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
+    filterLayout = new QHBoxLayout();
+    modeFilter = new QComboBox(this);
+    modeFilter->addItem("All modes", QString());
+    modeFilter->addItem("PvP", QString("PvP"));
+    modeFilter->addItem("PvAI", QString("PvAI"));
+    winnerFilter = new QComboBox(this);
+    winnerFilter->addItem("All results", QString());
+    for (const char* winner : { "You", "AI", "Player 1", "Player 2", "Draw" })
+        winnerFilter->addItem(winner, QString(winner));
+    periodFilter = new QComboBox(this);
+    periodFilter->addItem("Any time", 0);
+    periodFilter->addItem("Today", 1);
+    periodFilter->addItem("Last 7 days", 7);
+    periodFilter->addItem("Last 30 days", 30);
+    periodFilter->addItem("Last year", 365);
+    opponentFilter = new QLineEdit(this);
+    opponentFilter->setPlaceholderText("Opponent");
+    opponentFilter->setClearButtonEnabled(true);
+    filterLayout->addWidget(modeFilter);
+    filterLayout->addWidget(winnerFilter);
+    filterLayout->addWidget(periodFilter);
+    filterLayout->addWidget(opponentFilter);
+    // Typing re-queries once the user pauses rather than on every key.
+    filterTimer = new QTimer(this);
+    filterTimer->setSingleShot(true);
+    filterTimer->setInterval(200);
+    historyModel = new GameHistoryModel(this);
+    historyView = new QTableView(this);
+    historyView->setModel(historyModel);
+    historyView->setMinimumSize(420, 320);
+    historyView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    historyView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    historyView->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
+    historyView->verticalHeader()->hide();
+    historyView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    historyView->horizontalHeader()->setSortIndicator(GameHistoryModel::PlayedColumn, Qt::DescendingOrder);
+    historyView->setSortingEnabled(true);
     closeButton = new QPushButton("Close", this);
     titleLabel = new QLabel("Game History", this);
     titleLabel->setAlignment(Qt::AlignCenter);
     titleLabel->setStyleSheet("font-size: 20px; font-weight: bold;");
     mainLayout->addWidget(titleLabel);
-    mainLayout->addWidget(historyTextEdit);
+    mainLayout->addLayout(filterLayout);
+    mainLayout->addWidget(historyView);
     mainLayout->addWidget(closeButton);
     connect(closeButton, &QPushButton::clicked, this, &HistoryDialog::on_closeButton_clicked);
-    displayGameHistory();
+    connect(modeFilter, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &HistoryDialog::applyFilter);
+    connect(winnerFilter, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &HistoryDialog::applyFilter);
+    connect(periodFilter, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &HistoryDialog::applyFilter);
+    connect(opponentFilter, &QLineEdit::textChanged, filterTimer, QOverload<>::of(&QTimer::start));
+    connect(filterTimer, &QTimer::timeout, this, &HistoryDialog::applyFilter);
+    updateTitle();
 }
 
 HistoryDialog::~HistoryDialog()
 {
-    if (historyTextEdit) delete historyTextEdit;
+    if (modeFilter) delete modeFilter;
+    if (winnerFilter) delete winnerFilter;
+    if (periodFilter) delete periodFilter;
+    if (opponentFilter) delete opponentFilter;
+    if (filterLayout) delete filterLayout;
+    if (historyView) delete historyView;
+    if (historyModel) delete historyModel;
     if (closeButton) delete closeButton;
     if (titleLabel) delete titleLabel;
     if (mainLayout) delete mainLayout;
 }
 
-void HistoryDialog::setGameHistory(const std::vector<GameRecord>& history)
+void HistoryDialog::setGameHistory(const GameHistoryStore::Snapshot& history)
 {
-    gameHistory = history;
-    displayGameHistory();
+    historyModel->setRecords(history);
+    historyView->scrollToTop();
+    updateTitle();
 }
 
-void HistoryDialog::displayGameHistory()
+void HistoryDialog::setDatabaseSource(DatabaseManager* manager, const QString& username)
 {
-    historyTextEdit->clear();
-    if (gameHistory.empty())
-    {
-        historyTextEdit->append("No games have been played yet.");
-        return;
-    }
-    for (size_t i = 0; i < gameHistory.size(); ++i)
-    {
-        const GameRecord &record = gameHistory[i];
-        QString gameInfo = QString("Game %1: Mode: %2, Winner: %3, Time: %4")
-                               .arg(static_cast<int>(i + 1))
-                               .arg(QString::fromStdString(record.mode))
-                               .arg(QString::fromStdString(record.winner))
-                               .arg(record.timestamp);
-        historyTextEdit->append(gameInfo);
-    }
-    historyTextEdit->verticalScrollBar()->setValue(historyTextEdit->verticalScrollBar()->maximum());
+    historyModel->setDatabaseSource(manager, username);
+    historyView->scrollToTop();
+    updateTitle();
+}
+
+// The model applies the filter as SQL predicates, so only matching rows
+// are counted and paged in.
+void HistoryDialog::applyFilter()
+{
+    filterTimer->stop();
+    HistoryFilter filter;
+    filter.mode = modeFilter->currentData().toString().toStdString();
+    filter.winner = winnerFilter->currentData().toString().toStdString();
+    filter.opponent = opponentFilter->text().trimmed();
+    int days = periodFilter->currentData().toInt();
+    if (days > 0)
+        filter.from = QDateTime(QDate::currentDate().addDays(1 - days), QTime(0, 0));
+    historyModel->setFilter(filter);
+    historyView->scrollToTop();
+    updateTitle();
+}
+
+void HistoryDialog::updateTitle()
+{
+    int games = historyModel->totalRowCount();
+    if (!historyModel->getFilter().isEmpty())
+        titleLabel->setText(QString("Game History (%1 matching)").arg(games));
+    else
+        titleLabel->setText(games == 0 ? QString("No games have been played yet.")
+                                       : QString("Game History (%1 games)").arg(games));
+}
+
+// Letting go of the snapshot means the next game appended to the store
+// does not have to copy the history first.
+void HistoryDialog::hideEvent(QHideEvent* event)
+{
+    historyModel->setRecords(GameHistoryStore::Snapshot());
+    QDialog::hideEvent(event);
 }
 
 void HistoryDialog::on_closeButton_clicked()
@@ -839,22 +3686,148 @@ void HistoryDialog::on_closeButton_clicked()
     this->close();
 }
 
+// ------------------------------------------------------------------
+// ReplayEngine Implementation
+
+ReplayEngine::ReplayEngine()
+    : cells(2, 0), boardSize(3), wordsPerSide(1), ply(0), speed(1.0)
+{
+}
+
+ReplayEngine::ReplayEngine(const std::vector<Move>& moves, int boardSize)
+    : ReplayEngine()
+{
+    load(moves, boardSize);
+}
+
+// Moves outside the board leave the position unchanged, so every ply
+// still has a snapshot and ply numbers match move numbers.
+void ReplayEngine::load(const std::vector<Move>& gameMoves, int size)
+{
+    AllocationScope allocations(AllocationTracker::GameHistory);
+    moves = gameMoves;
+    boardSize = qBound(1, size, static_cast<int>(MaxBoardSize));
+    wordsPerSide = (boardSize * boardSize + 63) / 64;
+    ply = 0;
+
+    const size_t stride = 2 * size_t(wordsPerSide);
+    cells.assign(stride, 0);
+    cells.reserve(stride * (moves.size() + 1));
+    for (const Move& move : moves) {
+        size_t next = cells.size();
+        cells.resize(next + stride);
+        std::copy_n(cells.begin() + (next - stride), stride, cells.begin() + next);
+        if (move.row >= 0 && move.row < boardSize && move.col >= 0 && move.col < boardSize) {
+            int index = move.row * boardSize + move.col;
+            quint64 bit = quint64(1) << (index % 64);
+            quint64& xWord = cells[next + index / 64];
+            quint64& oWord = cells[next + wordsPerSide + index / 64];
+            xWord &= ~bit;
+            oWord &= ~bit;
+            if (move.player == 'X')
+                xWord |= bit;
+            else
+                oWord |= bit;
+        }
+    }
+}
+
+int ReplayEngine::boardSizeFor(const std::vector<Move>& moves)
+{
+    int size = 3;
+    for (const Move& move : moves)
+        size = std::max(size, std::max(move.row, move.col) + 1);
+    return size;
+}
+
+bool ReplayEngine::seek(int targetPly)
+{
+    if (targetPly < 0 || targetPly > getPlyCount())
+        return false;
+    ply = targetPly;
+    return true;
+}
+
+char ReplayEngine::cellAt(int row, int col) const
+{
+    if (row < 0 || row >= boardSize || col < 0 || col >= boardSize)
+        return ' ';
+    int index = row * boardSize + col;
+    quint64 bit = quint64(1) << (index % 64);
+    const quint64* xWord = getSnapshot(ply) + index / 64;
+    return (*xWord & bit) ? 'X' : (xWord[wordsPerSide] & bit) ? 'O' : ' ';
+}
+
+void ReplayEngine::setSpeed(double multiplier)
+{
+    speed = qBound(0.25, multiplier, 16.0);
+}
+
+int ReplayEngine::getIntervalMs() const
+{
+    return qMax(1, qRound(BaseIntervalMs / speed));
+}
+
 // ------------------------------------------------------------------
 // ReplayDialog Implementation
 
 ReplayDialog::ReplayDialog(const std::vector<Move>& moves, QWidget *parent)
-    : QDialog(parent), movesToReplay(moves), moveIndex(0)
+    : QDialog(parent)
 {
+    AllocationScope allocations(AllocationTracker::Widgets);
     this->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
     setWindowTitle("Animated Replay");
+
+    engine.load(moves, ReplayEngine::boardSizeFor(moves));
+
     boardLayout = new QGridLayout(this);
-    initializeBoard();
+    boardView = new BoardView(engine.getBoardSize(), this);
+    // Read-only, but drawn at full strength rather than shaded as a
+    // disabled board would be.
+    boardView->setFocusPolicy(Qt::NoFocus);
+    boardView->setAttribute(Qt::WA_TransparentForMouseEvents);
+    boardLayout->addWidget(boardView, 0, 0, Qt::AlignCenter);
+
+    controlLayout = new QHBoxLayout();
+    startButton = new QPushButton("|<", this);
+    backButton = new QPushButton("<", this);
+    playButton = new QPushButton("Pause", this);
+    forwardButton = new QPushButton(">", this);
+    endButton = new QPushButton(">|", this);
+    speedComboBox = new QComboBox(this);
+    for (double speed : { 0.5, 1.0, 2.0, 4.0, 8.0 })
+        speedComboBox->addItem(QString("%1x").arg(speed), speed);
+    speedComboBox->setCurrentIndex(1);
+    controlLayout->addWidget(startButton);
+    controlLayout->addWidget(backButton);
+    controlLayout->addWidget(playButton);
+    controlLayout->addWidget(forwardButton);
+    controlLayout->addWidget(endButton);
+    controlLayout->addWidget(speedComboBox);
+
+    positionSlider = new QSlider(Qt::Horizontal, this);
+    positionSlider->setRange(0, engine.getPlyCount());
+    positionLabel = new QLabel(this);
+    positionLabel->setAlignment(Qt::AlignCenter);
     closeButton = new QPushButton("Close", this);
-    boardLayout->addWidget(closeButton, 3, 0, 1, 3);
+    boardLayout->addLayout(controlLayout, 1, 0);
+    boardLayout->addWidget(positionSlider, 2, 0);
+    boardLayout->addWidget(positionLabel, 3, 0);
+    boardLayout->addWidget(closeButton, 4, 0);
+
     connect(closeButton, &QPushButton::clicked, this, &ReplayDialog::on_closeButton_clicked);
+    connect(startButton, &QPushButton::clicked, this, &ReplayDialog::on_startButton_clicked);
+    connect(backButton, &QPushButton::clicked, this, &ReplayDialog::on_backButton_clicked);
+    connect(playButton, &QPushButton::clicked, this, &ReplayDialog::on_playButton_clicked);
+    connect(forwardButton, &QPushButton::clicked, this, &ReplayDialog::on_forwardButton_clicked);
+    connect(endButton, &QPushButton::clicked, this, &ReplayDialog::on_endButton_clicked);
+    connect(speedComboBox, QOverload<int>::of(&QComboBox::activated), this, &ReplayDialog::on_speedComboBox_activated);
+    connect(positionSlider, &QSlider::valueChanged, this, &ReplayDialog::seekTo);
     timer = new QTimer(this);
     connect(timer, &QTimer::timeout, this, &ReplayDialog::playNextMove);
-    timer->start(500);
+
+    renderBoard();
+    setPlaying(engine.getPlyCount() > 0);
 }
 
 ReplayDialog::~ReplayDialog()
@@ -863,49 +3836,102 @@ ReplayDialog::~ReplayDialog()
         timer->stop();
         delete timer;
     }
-    for (QLabel* label : cellLabels) {
-        if (label) delete label;
-    }
-    cellLabels.clear();
+    if (boardView) delete boardView;
+    if (startButton) delete startButton;
+    if (backButton) delete backButton;
+    if (playButton) delete playButton;
+    if (forwardButton) delete forwardButton;
+    if (endButton) delete endButton;
+    if (speedComboBox) delete speedComboBox;
+    if (positionSlider) delete positionSlider;
+    if (positionLabel) delete positionLabel;
     if (closeButton) delete closeButton;
+    if (controlLayout) delete controlLayout;
     if (boardLayout) delete boardLayout;
 }
 
-void ReplayDialog::initializeBoard()
+// The board view only repaints cells whose mark changes, so a long seek
+// costs at most one tile per cell.
+void ReplayDialog::renderBoard()
 {
-    cellLabels.resize(9);
-    for (int i = 0; i < 9; ++i)
+    const int size = engine.getBoardSize();
+    for (int row = 0; row < size; ++row)
+        for (int col = 0; col < size; ++col)
+            boardView->setCell(row, col, engine.cellAt(row, col));
+
+    const int ply = engine.getPly();
     {
-        cellLabels[static_cast<size_t>(i)] = new QLabel("", this);
-        cellLabels[static_cast<size_t>(i)]->setFixedSize(80, 80);
-        cellLabels[static_cast<size_t>(i)]->setFrameStyle(QFrame::Box | QFrame::Plain);
-        cellLabels[static_cast<size_t>(i)]->setAlignment(Qt::AlignCenter);
-        cellLabels[static_cast<size_t>(i)]->setStyleSheet("font: 24px; background-color: #f0f0f0;");
+        QSignalBlocker blocker(positionSlider);
+        positionSlider->setValue(ply);
     }
-    int index = 0;
-    for (int row = 0; row < 3; ++row)
-        for (int col = 0; col < 3; ++col)
-            boardLayout->addWidget(cellLabels[static_cast<size_t>(index++)], row, col);
+    positionLabel->setText(QString("Move %1 / %2").arg(ply).arg(engine.getPlyCount()));
+    startButton->setEnabled(ply > 0);
+    backButton->setEnabled(ply > 0);
+    forwardButton->setEnabled(!engine.atEnd());
+    endButton->setEnabled(!engine.atEnd());
 }
 
-void ReplayDialog::playNextMove()
+void ReplayDialog::setPlaying(bool playing)
 {
-    if (moveIndex >= static_cast<int>(movesToReplay.size()))
-    {
+    if (playing)
+        timer->start(engine.getIntervalMs());
+    else
         timer->stop();
+    playButton->setText(playing ? "Pause" : "Play");
+}
+
+void ReplayDialog::playNextMove()
+{
+    if (engine.stepForward())
+        renderBoard();
+    if (engine.atEnd())
+        setPlaying(false);
+}
+
+// Manual navigation pauses playback.
+void ReplayDialog::seekTo(int ply)
+{
+    setPlaying(false);
+    if (engine.seek(ply))
+        renderBoard();
+}
+
+void ReplayDialog::on_startButton_clicked()
+{
+    seekTo(0);
+}
+
+void ReplayDialog::on_backButton_clicked()
+{
+    seekTo(engine.getPly() - 1);
+}
+
+void ReplayDialog::on_playButton_clicked()
+{
+    if (timer->isActive()) {
+        setPlaying(false);
         return;
     }
-    Move m = movesToReplay[static_cast<size_t>(moveIndex)];
-    int index = m.row * 3 + m.col;
-    if (index >= 0 && index < static_cast<int>(cellLabels.size()))
-    {
-        cellLabels[static_cast<size_t>(index)]->setText(QString(QChar(m.player)));
-        if (m.player == 'X')
-            cellLabels[static_cast<size_t>(index)]->setStyleSheet("font: 24px; background-color: #87CEFA; border: 1px solid #ccc;");
-        else
-            cellLabels[static_cast<size_t>(index)]->setStyleSheet("font: 24px; background-color: #FFA07A; border: 1px solid #ccc;");
-    }
-    moveIndex++;
+    if (engine.atEnd() && engine.seek(0))
+        renderBoard();
+    setPlaying(engine.getPlyCount() > 0);
+}
+
+void ReplayDialog::on_forwardButton_clicked()
+{
+    seekTo(engine.getPly() + 1);
+}
+
+void ReplayDialog::on_endButton_clicked()
+{
+    seekTo(engine.getPlyCount());
+}
+
+void ReplayDialog::on_speedComboBox_activated(int index)
+{
+    engine.setSpeed(speedComboBox->itemData(index).toDouble());
+    if (timer->isActive())
+        timer->setInterval(engine.getIntervalMs());
 }
 
 void ReplayDialog::on_closeButton_clicked()
@@ -916,21 +3942,34 @@ void ReplayDialog::on_closeButton_clicked()
 // ------------------------------------------------------------------
 // MainWindow Implementation
 
-std::vector<GameRecord> MainWindow::gameHistory;
+GameHistoryStore MainWindow::gameHistory;
 QString MainWindow::currentUser = "";
 DatabaseManager* MainWindow::dbManager = nullptr;
 GameMetrics MainWindow::gameMetrics;
 PerformanceMonitor MainWindow::loginPerformanceMonitor("Login Operations");
+PerformanceMonitor MainWindow::aiPerformanceMonitor("AI Decision Making");
+PerformanceMonitor MainWindow::thinkTimeMonitor("Human Think Time");
+PerformanceMonitor MainWindow::inputLatencyMonitor("Click to Paint");
+PerformanceMonitor MainWindow::clickToMoveMonitor("Click to Move");
+MetricsExporter* MainWindow::metricsExporter = nullptr;
 
 MainWindow::MainWindow(QWidget *parent)
-    : QMainWindow(parent), gameDialog(nullptr), historyDialog(nullptr)
+    : QMainWindow(parent), gameDialog(nullptr), historyDialog(nullptr), metricsServer(nullptr)
 {
-    ui = new Ui::MainWindow();
-    ui->setupUi(this);
+    {
+        AllocationScope allocations(AllocationTracker::Widgets);
+        ui = new Ui::MainWindow();
+        ui->setupUi(this);
+    }
 
-    dbManager = new DatabaseManager();
+    TraceRecorder::setOutputFile(qEnvironmentVariable("TICTACTOE_TRACE_FILE"));
+
+    dbManager = new DatabaseManager("tictactoe.db",
+                                    DatabaseProfile::fromName(qEnvironmentVariable("TICTACTOE_DB_PROFILE")));
     if (!dbManager->initializeDatabase()) {
         QMessageBox::critical(this, "Database Error", "Failed to initialize database!");
+    } else {
+        dbManager->loadGameMetrics(gameMetrics);
     }
 
     connect(ui->SignIn, &QPushButton::clicked, this, &MainWindow::signInButtonClicked);
@@ -940,44 +3979,75 @@ MainWindow::MainWindow(QWidget *parent)
 
     gameDialog = new GameDialog(this);
     historyDialog = new HistoryDialog(this);
+
+    QString exportPath = qEnvironmentVariable("TICTACTOE_METRICS_EXPORT");
+    if (!exportPath.isEmpty()) {
+        metricsExporter = new MetricsExporter(exportPath);
+        QJsonObject config;
+        config["databaseProfile"] = dbManager->getProfile().name;
+        config["traceFile"] = TraceRecorder::getOutputFile();
+        config["metricsPort"] = qEnvironmentVariable("TICTACTOE_METRICS_PORT");
+        metricsExporter->beginSession(config);
+    }
+
+    // Optional scrape endpoint, e.g. TICTACTOE_METRICS_PORT=9464.
+    int metricsPort = qEnvironmentVariableIntValue("TICTACTOE_METRICS_PORT");
+    if (metricsPort > 0 && metricsPort <= 65535)
+        startMetricsServer(static_cast<quint16>(metricsPort));
 }
 
 MainWindow::~MainWindow()
 {
+    // Deleting the game dialog finishes its queued background saves and
+    // their snapshots, so the summaries and the final snapshot come last.
+    if (gameDialog) {
+        delete gameDialog;
+        gameDialog = nullptr;
+    }
+    loginPerformanceMonitor.logSummary();
+    if (dbManager)
+        dbManager->getPerformanceMonitor().logSummary();
+    if (AllocationTracker::isEnabled())
+        qDebug().noquote() << PerformanceMonitor::getAllocationReport();
+    if (TraceRecorder::isEnabled() && TraceRecorder::flush())
+        qDebug() << "Trace written to" << TraceRecorder::getOutputFile();
+    exportMetricsSnapshot();
+
     if (ui) delete ui;
-    if (gameDialog) delete gameDialog;
     if (historyDialog) delete historyDialog;
     if (dbManager) delete dbManager;
+    delete metricsExporter;
+    metricsExporter = nullptr;
 }
 
 void MainWindow::signInButtonClicked()
 {
     static int signInAttempts = 0;
 
-    loginPerformanceMonitor.startMeasurement();
+    ScopedProbe probe("login.signIn", &loginPerformanceMonitor);
 
     QString username = ui->Username->text();
     QString password = ui->Password->text();
 
     if (username.isEmpty() || password.isEmpty()) {
         QMessageBox::warning(this, "Sign In", "Username and password cannot be empty.");
-        loginPerformanceMonitor.stopMeasurement();
+        probe.stop();
         return;
     }
 
     if (dbManager->verifyUser(username, password))
     {
         signInAttempts = 0;
-        loginPerformanceMonitor.stopMeasurement();
+        probe.stop();
 
         QMessageBox::information(this, "Sign In", "Sign in successful!");
         currentUser = username;
-        loadGameHistory();
+        beginHistorySession();
         ui->stackedWidget->setCurrentIndex(1);
     }
     else
     {
-        loginPerformanceMonitor.stopMeasurement();
+        probe.stop();
         signInAttempts++;
         if (signInAttempts >= 3)
         {
@@ -996,7 +4066,7 @@ void MainWindow::signInButtonClicked()
                         QMessageBox::information(this, "Password Updated", "Your password has been updated successfully.");
                         signInAttempts = 0;
                         currentUser = username;
-                        loadGameHistory();
+                        beginHistorySession();
                         ui->stackedWidget->setCurrentIndex(1);
                     } else {
                         QMessageBox::critical(this, "Error", "Failed to update password.");
@@ -1021,7 +4091,7 @@ void MainWindow::signInButtonClicked()
 
 void MainWindow::signUpButtonClicked()
 {
-    loginPerformanceMonitor.startMeasurement();
+    ScopedProbe probe("login.signUp", &loginPerformanceMonitor);
 
     QString username = ui->Username->text();
     QString password = ui->Password->text();
@@ -1029,39 +4099,99 @@ void MainWindow::signUpButtonClicked()
     if (username.isEmpty() || password.isEmpty())
     {
         QMessageBox::warning(this, "Sign Up", "Username and password cannot be empty.");
-        loginPerformanceMonitor.stopMeasurement();
+        probe.stop();
         return;
     }
 
     if (dbManager->saveUser(username, password))
     {
-        loginPerformanceMonitor.stopMeasurement();
+        probe.stop();
 
         QMessageBox::information(this, "Sign Up", "Account created successfully!");
         currentUser = username;
-        loadGameHistory();
+        beginHistorySession();
         ui->stackedWidget->setCurrentIndex(1);
     }
     else
     {
-        loginPerformanceMonitor.stopMeasurement();
+        probe.stop();
         QMessageBox::warning(this, "Sign Up", "Username already exists or database error occurred.");
     }
 }
 
-void MainWindow::loadGameHistory()
+void MainWindow::startMetricsServer(quint16 port)
 {
-    if (!currentUser.isEmpty() && dbManager) {
-        gameHistory = dbManager->loadGameHistory(currentUser);
+    metricsServer = new MetricsServer(this);
+
+    metricsServer->addHistogram("tictactoe_ai_decision_seconds", "Time the AI spends choosing a move.",
+                                [] { return aiPerformanceMonitor.getHistogram(); });
+    metricsServer->addHistogram("tictactoe_login_seconds", "Sign in and sign up latency.",
+                                [] { return loginPerformanceMonitor.getHistogram(); });
+    metricsServer->addHistogram("tictactoe_think_time_seconds", "Time a human player takes per move.",
+                                [] { return thinkTimeMonitor.getHistogram(); });
+    metricsServer->addHistogram("tictactoe_click_to_paint_seconds", "Cell click until the cell repaints.",
+                                [] { return inputLatencyMonitor.getHistogram(); });
+    metricsServer->addHistogram("tictactoe_click_to_move_seconds", "Cell click until the move is applied.",
+                                [] { return clickToMoveMonitor.getHistogram(); });
+    for (int s = 0; s < DatabaseManager::StatementCount; ++s) {
+        DatabaseManager::Statement statement = static_cast<DatabaseManager::Statement>(s);
+        QString operation = dbManager->getStatementMonitor(statement).getName().toLower().replace(' ', '_');
+        metricsServer->addHistogram("tictactoe_db_operation_seconds", "Database statement latency.",
+                                    [statement] { return dbManager->getStatementMonitor(statement).getHistogram(); },
+                                    QString("operation=\"%1\"").arg(operation));
+    }
+
+    metricsServer->addCounter("tictactoe_games_played_total", "Games finished in all sessions.",
+                              [] { return double(gameMetrics.getTotalGames()); });
+    metricsServer->addCounter("tictactoe_game_results_total", "Finished games by result, in all sessions.",
+                              [] { return double(gameMetrics.getPlayerWins()); }, "result=\"player_win\"");
+    metricsServer->addCounter("tictactoe_game_results_total", "Finished games by result, in all sessions.",
+                              [] { return double(gameMetrics.getAiWins()); }, "result=\"ai_win\"");
+    metricsServer->addCounter("tictactoe_game_results_total", "Finished games by result, in all sessions.",
+                              [] { return double(gameMetrics.getDraws()); }, "result=\"draw\"");
+
+    for (int s = 0; AllocationTracker::isEnabled() && s < AllocationTracker::SubsystemCount; ++s) {
+        AllocationTracker::Subsystem subsystem = static_cast<AllocationTracker::Subsystem>(s);
+        QString label = QString("subsystem=\"%1\"")
+                            .arg(QString(AllocationTracker::subsystemName(subsystem)).toLower().replace(' ', '_'));
+        metricsServer->addGauge("tictactoe_heap_live_bytes", "Heap bytes currently allocated by subsystem.",
+                                [subsystem] { return double(AllocationTracker::getStats(subsystem).liveBytes); }, label);
+        metricsServer->addGauge("tictactoe_heap_peak_bytes", "Highest live heap bytes by subsystem.",
+                                [subsystem] { return double(AllocationTracker::getStats(subsystem).peakBytes); }, label);
+        metricsServer->addCounter("tictactoe_heap_allocations_total", "Heap allocations by subsystem.",
+                                  [subsystem] { return double(AllocationTracker::getStats(subsystem).allocations); }, label);
     }
+
+    if (metricsServer->start(port))
+        qDebug() << "Serving metrics on http://127.0.0.1:" + QString::number(metricsServer->serverPort()) + "/metrics";
 }
 
-void MainWindow::saveGameHistory()
+std::vector<PerformanceMonitor> MainWindow::snapshotMonitors()
 {
-    if (!currentUser.isEmpty() && dbManager && !gameHistory.empty()) {
-        const GameRecord& lastRecord = gameHistory.back();
-        dbManager->saveGameRecord(currentUser, lastRecord);
+    std::vector<PerformanceMonitor> monitors = {
+        loginPerformanceMonitor, aiPerformanceMonitor, thinkTimeMonitor, inputLatencyMonitor, clickToMoveMonitor
+    };
+    if (dbManager) {
+        monitors.push_back(dbManager->getInitializeStats().latency);
+        for (int s = 0; s < DatabaseManager::StatementCount; ++s)
+            monitors.push_back(dbManager->getStatementMonitor(static_cast<DatabaseManager::Statement>(s)));
     }
+    return monitors;
+}
+
+void MainWindow::exportMetricsSnapshot()
+{
+    if (!metricsExporter)
+        return;
+    metricsExporter->appendSnapshot(snapshotMonitors(), gameMetrics);
+}
+
+// The history dialog and the replay picker page the signed-in user's
+// games from the database, so signing in only drops the previous
+// user's session games rather than loading the whole history.
+void MainWindow::beginHistorySession()
+{
+    gameHistory.clear();
 }
 
 void MainWindow::playGameButtonClicked()
@@ -1083,6 +4213,9 @@ void MainWindow::viewHistoryButtonClicked()
 {
     if (!historyDialog)
         historyDialog = new HistoryDialog(this);
-    historyDialog->setGameHistory(gameHistory);
+    if (!currentUser.isEmpty() && dbManager)
+        historyDialog->setDatabaseSource(dbManager, currentUser);
+    else
+        historyDialog->setGameHistory(gameHistory.snapshot());
     historyDialog->exec();
 }
@@ -100,3 +100,985 @@ void TestGameBoard::testReplayIntegration()
     dialog.on_replayButton_clicked(); // should fill comboBox
     QCOMPARE(comboBox->count(), 2); // "Select..." + "Game 1"
 }
+void TestGameBoard::testPreparedStatementReuse()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    DatabaseManager db(dir.filePath("statements.db"));
+    QVERIFY(db.initializeDatabase());
+    QVERIFY(db.saveUser("alice", "pw"));
+
+    GameRecord record;
+    record.mode = "PvP";
+    record.winner = "Player 1";
+    record.moves = {{0, 0, 'X'}, {1, 1, 'O'}};
+
+    for (int i = 0; i < 3; ++i)
+        QVERIFY(db.saveGameRecord("alice", record));
+    QCOMPARE(db.loadGameHistory("alice").size(), static_cast<size_t>(3));
+    QCOMPARE(db.loadGameHistory("alice").size(), static_cast<size_t>(3)); // reused SELECT must be reset
+    QVERIFY(db.verifyUser("alice", "pw"));
+    QVERIFY(!db.verifyUser("alice", "wrong"));
+
+    QCOMPARE(db.getStatementMonitor(DatabaseManager::InsertGameStatement).getMeasurementCount(), static_cast<size_t>(3));
+    QCOMPARE(db.getStatementMonitor(DatabaseManager::LoadHistoryStatement).getMeasurementCount(), static_cast<size_t>(2));
+    QCOMPARE(db.getStatementMonitor(DatabaseManager::VerifyUserStatement).getMeasurementCount(), static_cast<size_t>(2));
+}
+void TestGameBoard::testDatabaseOperationStats()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    DatabaseManager db(dir.filePath("stats.db"));
+    QVERIFY(db.initializeDatabase());
+    QVERIFY(db.saveUser("bob", "pw"));
+
+    GameRecord record;
+    record.mode = "PvAI";
+    record.winner = "AI";
+    record.moves = {{0, 0, 'X'}, {1, 1, 'O'}};
+    QVERIFY(db.saveGameRecord("bob", record));
+    QVERIFY(db.saveGameRecord("bob", record));
+    QCOMPARE(db.loadGameHistory("bob").size(), static_cast<size_t>(2));
+
+    const DatabaseOperationStats& inserts = db.getStatementStats(DatabaseManager::InsertGameStatement);
+    const DatabaseOperationStats& loads = db.getStatementStats(DatabaseManager::LoadHistoryStatement);
+    QCOMPARE(inserts.rows, static_cast<quint64>(2));
+    QCOMPARE(loads.rows, static_cast<quint64>(2));
+    QVERIFY(loads.bytes > 0);
+    QVERIFY(loads.latency.getPercentile(99) <= loads.latency.getMaxTime());
+    QCOMPARE(db.getInitializeStats().latency.getMeasurementCount(), static_cast<size_t>(1));
+    // One aggregate sample per call: initialize, saveUser, two saves, one load.
+    QCOMPARE(db.getPerformanceMonitor().getMeasurementCount(), static_cast<size_t>(5));
+    QVERIFY(db.getProfileReport().contains("Insert Game"));
+}
+void TestGameBoard::testUserStatsMaintainedOnInsert()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    DatabaseManager db(dir.filePath("userstats.db"));
+    QVERIFY(db.initializeDatabase());
+    QVERIFY(db.saveUser("carol", "pw"));
+
+    GameRecord record;
+    record.mode = "PvAI";
+    record.moves = {{0, 0, 'X'}};
+    const char* winners[] = { "You", "You", "AI", "Draw", "You", "You", "You" };
+    for (const char* winner : winners) {
+        record.winner = winner;
+        record.durationMs = 1000.0;
+        QVERIFY(db.saveGameRecord("carol", record));
+    }
+    record.mode = "PvP";
+    record.winner = "Player 2";
+    QVERIFY(db.saveGameRecord("carol", record));
+
+    UserStats stats = db.loadUserStats("carol");
+    QCOMPARE(stats.totalGames, 8);
+    QCOMPARE(stats.wins, 5);
+    QCOMPARE(stats.losses, 2);
+    QCOMPARE(stats.draws, 1);
+    QCOMPARE(stats.pvaiGames, 7);
+    QCOMPARE(stats.pvpGames, 1);
+    QCOMPARE(stats.bestWinStreak, 3);
+    QCOMPARE(stats.currentStreak, -1);
+    QCOMPARE(stats.getAverageDurationMs(), 1000.0);
+    QCOMPARE(db.loadUserStats("nobody").totalGames, 0);
+}
+void TestGameBoard::testConcurrentDatabaseAccess()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    DatabaseManager db(dir.filePath("concurrent.db"));
+    DatabaseManager other(dir.filePath("other.db")); // must not clobber db's connection
+    QVERIFY(db.initializeDatabase());
+    QVERIFY(other.initializeDatabase());
+    QVERIFY(db.saveUser("dave", "pw"));
+
+    GameRecord record;
+    record.mode = "PvP";
+    record.winner = "Draw";
+    record.moves = {{0, 0, 'X'}, {1, 1, 'O'}};
+
+    const int threadCount = 4;
+    const int gamesPerThread = 25;
+    std::atomic<int> failures(0);
+    std::vector<QThread*> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.push_back(QThread::create([&]() {
+            for (int i = 0; i < gamesPerThread; ++i)
+                if (!db.saveGameRecord("dave", record))
+                    failures++;
+        }));
+        threads.back()->start();
+    }
+    for (QThread* thread : threads) {
+        QVERIFY(thread->wait(30000));
+        delete thread;
+    }
+
+    QCOMPARE(failures.load(), 0);
+    QCOMPARE(db.getConnectionCount(), 1); // worker connections are released on finish
+    QCOMPARE(db.loadGameHistory("dave").size(), static_cast<size_t>(threadCount * gamesPerThread));
+    QCOMPARE(db.loadUserStats("dave").draws, threadCount * gamesPerThread);
+    QCOMPARE(other.getConnectionCount(), 1);
+}
+void TestGameBoard::testResourceSampling()
+{
+#ifdef __linux__
+    PerformanceMonitor::sampleResourceUsage();
+    ResourceUsage usage = PerformanceMonitor::sampleResourceUsage();
+    QVERIFY(usage.rssMB > 0.0);
+    QVERIFY(usage.peakRssMB >= usage.rssMB);
+    QVERIFY(usage.minorPageFaults > 0);
+    QVERIFY(usage.processCpuPercent >= 0.0);
+    QVERIFY(PerformanceMonitor::getCurrentMemoryUsageMB() > 0.0);
+#else
+    QSKIP("/proc sampling is Linux only");
+#endif
+}
+void TestGameBoard::testLatencyHistogram()
+{
+    PerformanceMonitor monitor("Histogram");
+    for (int i = 1; i <= 1000; ++i)
+        monitor.addMeasurement(i / 10.0); // 0.1 .. 100 ms
+
+    QCOMPARE(monitor.getMeasurementCount(), static_cast<size_t>(1000));
+    QCOMPARE(monitor.getMinTime(), 0.1);
+    QCOMPARE(monitor.getMaxTime(), 100.0);
+    QVERIFY(qAbs(monitor.getAverageTime() - 50.05) < 1e-9);
+    QVERIFY(qAbs(monitor.getPercentile(50) - 50.0) < 50.0 * 0.04);
+    QVERIFY(qAbs(monitor.getPercentile(99) - 99.0) < 99.0 * 0.04);
+    QCOMPARE(monitor.getPercentile(100), 100.0);
+    QCOMPARE(monitor.getHistogram().countAtOrBelow(100.0), static_cast<quint64>(1000));
+
+    // A bucket straddling the bound is left out rather than counted whole.
+    LatencyHistogram straddle;
+    straddle.record(1.005);   // bucket 992..1007 us
+    straddle.record(2.0);
+    QCOMPARE(straddle.countAtOrBelow(1.0), static_cast<quint64>(0));
+    QCOMPARE(straddle.countAtOrBelow(1.5), static_cast<quint64>(1));
+
+    // Values below 64 us land in exact buckets.
+    LatencyHistogram exact;
+    exact.record(0.010);
+    exact.record(0.020);
+    exact.record(0.030);
+    QCOMPARE(exact.getPercentile(50), 0.020);
+
+    PerformanceMonitor windowed("Window");
+    windowed.setRollingWindow(60000);
+    windowed.addMeasurement(5.0);
+    windowed.addMeasurement(7.0);
+    QCOMPARE(windowed.getWindowHistogram().getCount(), static_cast<quint64>(2));
+    QCOMPARE(windowed.getWindowPercentile(100), 7.0);
+}
+void TestGameBoard::testScopedProbes()
+{
+#ifdef TICTACTOE_DISABLE_PROBES
+    QSKIP("probes are compiled out");
+#else
+    ProbeEventBuffer::drainAll();
+
+    PerformanceMonitor monitor("Probe");
+    {
+        ScopedProbe probe("test.scoped", &monitor);
+    }
+    ScopedProbe early("test.early");
+    double elapsed = early.stop();
+    QCOMPARE(early.stop(), 0.0); // second stop is a no-op
+    QVERIFY(elapsed >= 0.0);
+    QCOMPARE(monitor.getMeasurementCount(), static_cast<size_t>(1));
+
+    std::vector<ProbeEvent> events = ProbeEventBuffer::drainAll();
+    QCOMPARE(events.size(), static_cast<size_t>(2));
+    QCOMPARE(QString(events[0].name), QString("test.scoped"));
+    QCOMPARE(PerformanceMonitor::aggregateProbeEvents(events).size(), static_cast<size_t>(2));
+
+    // Overhead of a bare probe, including the ring buffer write. Logged
+    // only: wall-clock limits belong in the test_performance gate.
+    const int iterations = 100000;
+    qint64 start = ProbeEventBuffer::nowNs();
+    for (int i = 0; i < iterations; ++i) {
+        ScopedProbe probe("test.overhead");
+    }
+    double perProbeNs = double(ProbeEventBuffer::nowNs() - start) / iterations;
+    qInfo() << "ScopedProbe overhead:" << perProbeNs << "ns";
+
+    quint64 droppedBefore = ProbeEventBuffer::getDroppedEventCount();
+    QCOMPARE(ProbeEventBuffer::drainAll().size(), static_cast<size_t>(ProbeEventBuffer::Capacity - 1));
+    QCOMPARE(ProbeEventBuffer::getDroppedEventCount() - droppedBefore,
+             static_cast<quint64>(iterations - (ProbeEventBuffer::Capacity - 1)));
+#endif
+}
+void TestGameBoard::testChromeTraceExport()
+{
+#ifdef TICTACTOE_DISABLE_PROBES
+    QSKIP("probes are compiled out");
+#else
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString tracePath = dir.filePath("trace.json");
+
+    ProbeEventBuffer::drainAll();
+    TraceRecorder::setOutputFile(tracePath);
+    QVERIFY(TraceRecorder::isEnabled());
+    {
+        ScopedProbe outer("test.outer");
+        ScopedProbe inner("test.inner");
+    }
+    {
+        DatabaseManager db(dir.filePath("trace.db"));
+        QVERIFY(db.initializeDatabase());
+    }
+    TraceRecorder::collect();
+    QCOMPARE(TraceRecorder::getEventCount(), static_cast<size_t>(3));
+    QVERIFY(TraceRecorder::flush());
+    TraceRecorder::setOutputFile(QString());
+    QVERIFY(!TraceRecorder::isEnabled());
+
+    QFile file(tracePath);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QMap<QString, QJsonObject> spans;
+    for (const QJsonValue& value : document.object()["traceEvents"].toArray()) {
+        QJsonObject event = value.toObject();
+        if (event["ph"].toString() == "X")
+            spans[event["name"].toString()] = event;
+    }
+    QCOMPARE(spans.size(), 3);
+    QVERIFY(spans.contains("db.initialize"));
+    QCOMPARE(spans["db.initialize"]["cat"].toString(), QString("db"));
+
+    // The inner span nests inside the outer one on the same thread.
+    QJsonObject outer = spans["test.outer"];
+    QJsonObject inner = spans["test.inner"];
+    QCOMPARE(inner["tid"].toInt(), outer["tid"].toInt());
+    QVERIFY(inner["ts"].toDouble() >= outer["ts"].toDouble());
+    QVERIFY(inner["ts"].toDouble() + inner["dur"].toDouble()
+            <= outer["ts"].toDouble() + outer["dur"].toDouble() + 0.001);
+#endif
+}
+void TestGameBoard::testMetricsEndpoint()
+{
+    PerformanceMonitor latency("Latency");
+    latency.addMeasurement(0.2);   // 0.0002 s
+    latency.addMeasurement(3.0);   // 0.003 s
+    int games = 7;
+
+    MetricsServer metrics;
+    metrics.addHistogram("test_latency_seconds", "Test latency.", [&] { return latency.getHistogram(); },
+                         "operation=\"probe\"");
+    metrics.addCounter("test_games_total", "Test games.", [&] { return double(games); });
+    QVERIFY(metrics.start());
+    QVERIFY(metrics.serverPort() != 0);
+
+    QTcpSocket client;
+    QByteArray response;
+    connect(&client, &QTcpSocket::readyRead, [&] { response += client.readAll(); });
+    client.connectToHost(QHostAddress::LocalHost, metrics.serverPort());
+    QTRY_COMPARE(client.state(), QAbstractSocket::ConnectedState);
+    client.write("GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    QTRY_COMPARE(client.state(), QAbstractSocket::UnconnectedState);
+
+    QVERIFY(response.startsWith("HTTP/1.1 200 OK\r\n"));
+    QString body = QString::fromUtf8(response.mid(response.indexOf("\r\n\r\n") + 4));
+    QVERIFY(body.contains("# TYPE test_latency_seconds histogram\n"));
+    QVERIFY(body.contains("test_latency_seconds_bucket{operation=\"probe\",le=\"0.0001\"} 0\n"));
+    QVERIFY(body.contains("test_latency_seconds_bucket{operation=\"probe\",le=\"0.001\"} 1\n"));
+    QVERIFY(body.contains("test_latency_seconds_bucket{operation=\"probe\",le=\"+Inf\"} 2\n"));
+    QVERIFY(body.contains("test_latency_seconds_count{operation=\"probe\"} 2\n"));
+    QVERIFY(body.contains("# TYPE test_games_total counter\n"));
+    QVERIFY(body.contains("test_games_total 7\n"));
+    QCOMPARE(body, metrics.render());
+
+    // Anything but /metrics is a 404.
+    QTcpSocket other;
+    QByteArray notFound;
+    connect(&other, &QTcpSocket::readyRead, [&] { notFound += other.readAll(); });
+    other.connectToHost(QHostAddress::LocalHost, metrics.serverPort());
+    QTRY_COMPARE(other.state(), QAbstractSocket::ConnectedState);
+    other.write("GET / HTTP/1.1\r\n\r\n");
+    QTRY_VERIFY(notFound.startsWith("HTTP/1.1 404"));
+}
+void TestGameBoard::testMetricsExport()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    PerformanceMonitor ai("AI Decision Making");
+    for (int i = 1; i <= 100; ++i)
+        ai.addMeasurement(i * 0.1);
+    GameMetrics metrics;
+    metrics.startGame();
+    metrics.endGame("AI");
+    std::vector<PerformanceMonitor> monitors = { ai };
+
+    // Two sessions append to the same JSON Lines file.
+    QString jsonPath = dir.filePath("metrics.jsonl");
+    MetricsExporter first(jsonPath);
+    QCOMPARE(first.getFormat(), MetricsExporter::JsonLines);
+    QVERIFY(first.beginSession(QJsonObject{{"databaseProfile", "fast"}}));
+    QVERIFY(first.appendSnapshot(monitors, metrics));
+    QVERIFY(first.appendSnapshot(monitors, metrics));
+    MetricsExporter second(jsonPath);
+    QVERIFY(second.beginSession());
+    QVERIFY(second.appendSnapshot(monitors, metrics));
+    QVERIFY(first.getSessionId() != second.getSessionId());
+
+    QFile jsonFile(jsonPath);
+    QVERIFY(jsonFile.open(QIODevice::ReadOnly));
+    QList<QByteArray> lines = jsonFile.readAll().trimmed().split('\n');
+    QCOMPARE(lines.size(), 5);
+    QStringList types;
+    for (const QByteArray& line : lines) {
+        QJsonParseError error;
+        QJsonObject record = QJsonDocument::fromJson(line, &error).object();
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        types << record["type"].toString();
+        QVERIFY(!record["timestamp"].toString().isEmpty());
+    }
+    QCOMPARE(types, QStringList({"session", "snapshot", "snapshot", "session", "snapshot"}));
+
+    QJsonObject session = QJsonDocument::fromJson(lines[0]).object();
+    QCOMPARE(session["config"].toObject()["databaseProfile"].toString(), QString("fast"));
+    QCOMPARE(session["build"].toObject()["qtBuild"].toString(), QString(QT_VERSION_STR));
+
+    QJsonObject snapshot = QJsonDocument::fromJson(lines[2]).object();
+    QCOMPARE(snapshot["sequence"].toInt(), 2);
+    QCOMPARE(snapshot["game"].toObject()["aiWins"].toInt(), 1);
+    QJsonObject exported = snapshot["monitors"].toArray()[0].toObject();
+    QCOMPARE(exported["count"].toInt(), 100);
+    double bucketTotal = 0;
+    for (const QJsonValue& bucket : exported["bucketsUs"].toArray())
+        bucketTotal += bucket.toArray()[2].toDouble();
+    QCOMPARE(bucketTotal, 100.0);
+
+    // CSV writes its header once, however many sessions append.
+    QString csvPath = dir.filePath("metrics.csv");
+    for (int run = 0; run < 2; ++run) {
+        MetricsExporter csv(csvPath);
+        QCOMPARE(csv.getFormat(), MetricsExporter::Csv);
+        QVERIFY(csv.beginSession());
+        QVERIFY(csv.appendSnapshot(monitors, metrics));
+    }
+    QFile csvFile(csvPath);
+    QVERIFY(csvFile.open(QIODevice::ReadOnly));
+    QStringList rows = QString::fromUtf8(csvFile.readAll()).trimmed().split('\n');
+    QCOMPARE(rows.count(MetricsExporter::csvHeader()), 1);
+    QCOMPARE(rows.first(), MetricsExporter::csvHeader());
+    int columns = MetricsExporter::csvHeader().count(',');
+    int operationRows = 0;
+    for (const QString& row : rows) {
+        QCOMPARE(row.count(','), columns);
+        if (row.contains(",operation,AI Decision Making,"))
+            ++operationRows;
+    }
+    QCOMPARE(operationRows, 2);
+
+    // Snapshots from several threads land whole, each with its own sequence.
+    QString sharedPath = dir.filePath("shared.jsonl");
+    MetricsExporter shared(sharedPath);
+    QVERIFY(shared.beginSession());
+    std::vector<QThread*> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.push_back(QThread::create([&]() {
+            for (int i = 0; i < 10; ++i)
+                shared.appendSnapshot(monitors, metrics);
+        }));
+        writers.back()->start();
+    }
+    for (QThread* writer : writers) {
+        QVERIFY(writer->wait(30000));
+        delete writer;
+    }
+    QFile sharedFile(sharedPath);
+    QVERIFY(sharedFile.open(QIODevice::ReadOnly));
+    QList<QByteArray> sharedLines = sharedFile.readAll().trimmed().split('\n');
+    QCOMPARE(sharedLines.size(), 41);
+    for (int i = 1; i < sharedLines.size(); ++i)
+        QCOMPARE(QJsonDocument::fromJson(sharedLines[i]).object()["sequence"].toInt(), i);
+}
+void TestGameBoard::testGameMetricsAccounting()
+{
+    RunningStats running;
+    for (double value : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0})
+        running.add(value);
+    QCOMPARE(running.mean, 5.0);
+    QCOMPARE(running.getVariance(), 32.0 / 7.0);
+    QCOMPARE(running.min, 2.0);
+    QCOMPARE(running.max, 9.0);
+
+    GameContext alicePvai;
+    alicePvai.mode = "PvAI";
+    alicePvai.aiStrategy = "minimax";
+    alicePvai.user = "alice";
+    GameContext bobPvp;
+    bobPvp.mode = "PvP";
+    bobPvp.aiStrategy = "none";
+    bobPvp.user = "bob";
+
+    // A game is counted once, however often endGame() is called.
+    GameMetrics metrics;
+    QVERIFY(!metrics.endGame("AI", alicePvai));
+    metrics.startGame();
+    QVERIFY(metrics.endGame("AI", alicePvai));
+    QVERIFY(!metrics.endGame("AI", alicePvai));
+    QCOMPARE(metrics.getTotalGames(), 1);
+
+    metrics.recordGame("You", 100.0, alicePvai);
+    metrics.recordGame("Draw", 300.0, bobPvp);
+    QCOMPARE(metrics.getTotalGames(), 3);
+    QCOMPARE(metrics.getAiWins(), 1);
+    QCOMPARE(metrics.getPlayerWins(), 1);
+    QCOMPARE(metrics.getDraws(), 1);
+    QCOMPARE(metrics.getBreakdown(GameMetrics::ByMode).at("PvAI").games, 2);
+    QCOMPARE(metrics.getBreakdown(GameMetrics::ByMode).at("PvP").draws, 1);
+    QCOMPARE(metrics.getBreakdown(GameMetrics::ByAiStrategy).at("minimax").aiWins, 1);
+    QCOMPARE(metrics.getBreakdown(GameMetrics::ByBoardSize).at("3x3").games, 3);
+    QCOMPARE(metrics.getBreakdown(GameMetrics::ByUser).at("bob").durationMs.mean, 300.0);
+
+    // Totals and breakdowns survive a restart through the database.
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = dir.filePath("metrics.db");
+    {
+        DatabaseManager db(path);
+        QVERIFY(db.initializeDatabase());
+        QVERIFY(db.saveGameMetrics(metrics, alicePvai));
+        QVERIFY(db.saveGameMetrics(metrics, bobPvp));
+    }
+    DatabaseManager db(path);
+    QVERIFY(db.initializeDatabase());
+    GameMetrics restored;
+    QVERIFY(db.loadGameMetrics(restored));
+    QCOMPARE(restored.getTotalGames(), 3);
+    QCOMPARE(restored.getAverageGameDuration(), metrics.getAverageGameDuration());
+    QCOMPARE(restored.getTotals().durationMs.m2, metrics.getTotals().durationMs.m2);
+    for (int d = 0; d < GameMetrics::DimensionCount; ++d) {
+        GameMetrics::Dimension dimension = static_cast<GameMetrics::Dimension>(d);
+        QCOMPARE(restored.getBreakdown(dimension).size(), metrics.getBreakdown(dimension).size());
+    }
+    QCOMPARE(restored.getBreakdown(GameMetrics::ByUser).at("alice").playerWins, 1);
+
+    restored.recordGame("AI", 50.0, alicePvai);
+    QCOMPARE(restored.getBreakdown(GameMetrics::ByUser).at("alice").games, 3);
+}
+void TestGameBoard::testMoveTimings()
+{
+    GameBoard board(nullptr, 1);
+    QTest::qWait(20);
+    QVERIFY(board.makeMove(0, 0, 'X'));
+    Move first = board.getLastMove();
+    QCOMPARE(first.row, 0);
+    QVERIFY(first.offsetMs >= 20);
+    QCOMPARE(first.thinkMs, double(first.offsetMs));
+
+    QTest::qWait(30);
+    QVERIFY(board.makeMove(1, 1, 'O'));
+    Move second = board.getLastMove();
+    QVERIFY(second.thinkMs >= 30.0);
+    QCOMPARE(double(second.offsetMs), first.offsetMs + second.thinkMs);
+
+    // Timings round-trip through the moves column; old rows still parse.
+    std::vector<Move> moves = { first, second, {2, 2, 'X'} };
+    QString serialized = DatabaseManager::serializeMoves(moves);
+    std::vector<Move> parsed = DatabaseManager::parseMoves(serialized);
+    QCOMPARE(parsed.size(), static_cast<size_t>(3));
+    QCOMPARE(parsed[1].offsetMs, second.offsetMs);
+    QCOMPARE(parsed[1].thinkMs, second.thinkMs);
+    QCOMPARE(parsed[2].offsetMs, qint64(-1));
+
+    std::vector<Move> legacy = DatabaseManager::parseMoves("0-0-X;1-1-O");
+    QCOMPARE(legacy.size(), static_cast<size_t>(2));
+    QCOMPARE(legacy[1].player, 'O');
+    QCOMPARE(legacy[1].thinkMs, -1.0);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    DatabaseManager db(dir.filePath("timings.db"));
+    QVERIFY(db.initializeDatabase());
+    QVERIFY(db.saveUser("timer", "secret"));
+    GameRecord record;
+    record.mode = "PvP";
+    record.winner = "Draw";
+    record.moves = moves;
+    QVERIFY(db.saveGameRecord("timer", record));
+    std::vector<GameRecord> history = db.loadGameHistory("timer");
+    QCOMPARE(history.size(), static_cast<size_t>(1));
+    QCOMPARE(history[0].moves[0].offsetMs, first.offsetMs);
+    QCOMPARE(history[0].moves[1].thinkMs, second.thinkMs);
+}
+void TestGameBoard::testAllocationTracking()
+{
+    if (!AllocationTracker::isEnabled())
+        QSKIP("built without TICTACTOE_ALLOC_TRACKING");
+
+    AllocationStats before = AllocationTracker::getStats(AllocationTracker::AiSearch);
+    AllocationStats databaseBefore = AllocationTracker::getStats(AllocationTracker::Database);
+    std::vector<int>* block = nullptr;
+    {
+        AllocationScope scope(AllocationTracker::AiSearch);
+        block = new std::vector<int>(1000);
+        {
+            AllocationScope nested(AllocationTracker::Database);
+            delete new int(1);
+        }
+        delete new int(2);   // back to AiSearch after the nested scope
+    }
+    AllocationStats during = AllocationTracker::getStats(AllocationTracker::AiSearch);
+    QVERIFY(during.liveBytes - before.liveBytes >= 1000 * sizeof(int));
+    QVERIFY(during.peakBytes >= during.liveBytes);
+    QCOMPARE(during.allocations - before.allocations, quint64(3));
+    QCOMPARE(AllocationTracker::getStats(AllocationTracker::Database).allocations - databaseBefore.allocations,
+             quint64(1));
+
+    // Frees are charged to the allocating subsystem, whatever scope is active.
+    delete block;
+    AllocationStats after = AllocationTracker::getStats(AllocationTracker::AiSearch);
+    QCOMPARE(after.liveBytes, before.liveBytes);
+    QCOMPARE(after.deallocations - before.deallocations, quint64(3));
+    QVERIFY(PerformanceMonitor::getAllocationReport().contains("AI Search"));
+}
+void TestGameBoard::testHistoryModelPaging()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    DatabaseManager db(dir.filePath("paging.db"));
+    QVERIFY(db.initializeDatabase());
+    QVERIFY(db.saveUser("erin", "pw"));
+
+    const int games = GameHistoryModel::PageSize * 2 + 50;
+    const char* winners[] = { "You", "AI", "Draw" };
+    GameRecord record;
+    record.moves = {{0, 0, 'X'}};
+    for (int i = 0; i < games; ++i) {
+        record.mode = i % 2 ? "PvP" : "PvAI";
+        record.winner = winners[i % 3];
+        QVERIFY(db.saveGameRecord("erin", record));
+    }
+    QCOMPARE(db.countGameHistory("erin"), games);
+
+    GameHistoryModel model;
+    model.setDatabaseSource(&db, "erin");
+    QCOMPARE(model.totalRowCount(), games);
+    QCOMPARE(model.rowCount(), static_cast<int>(GameHistoryModel::PageSize));
+    QVERIFY(model.recordAt(0).id > model.recordAt(1).id); // newest first
+
+    model.sort(GameHistoryModel::WinnerColumn, Qt::AscendingOrder);
+    while (model.canFetchMore(QModelIndex()))
+        model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), games);
+    for (int row = 1; row < games; ++row) {
+        const GameRecord& prev = model.recordAt(row - 1);
+        const GameRecord& cur = model.recordAt(row);
+        QVERIFY(prev.winner < cur.winner || (prev.winner == cur.winner && prev.id < cur.id));
+    }
+    QCOMPARE(model.data(model.index(0, GameHistoryModel::WinnerColumn)).toString(), QString("AI"));
+    QCOMPARE(db.getStatementStats(DatabaseManager::LoadHistoryPageStatement).rows, static_cast<quint64>(games + GameHistoryModel::PageSize));
+
+    record.mode = "PvP";
+    record.winner = "You";
+    std::vector<GameRecord> history(GameHistoryModel::PageSize + 1, record);
+    history.front().mode = "PvAI";
+    history.back().winner = "AI";
+    GameHistoryStore store;
+    store = history;
+    GameHistoryModel memory;
+    memory.setRecords(store.snapshot());
+    QCOMPARE(memory.rowCount(), static_cast<int>(GameHistoryModel::PageSize));
+    QCOMPARE(memory.recordAt(0).winner, std::string("AI")); // last played first
+    memory.sort(GameHistoryModel::ModeColumn, Qt::AscendingOrder);
+    QCOMPARE(memory.recordAt(0).mode, std::string("PvAI"));
+    memory.fetchMore(QModelIndex());
+    QCOMPARE(memory.rowCount(), static_cast<int>(history.size()));
+    QVERIFY(!memory.canFetchMore(QModelIndex()));
+}
+void TestGameBoard::testHistoryFiltering()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    DatabaseManager db(dir.filePath("filter.db"));
+    QVERIFY(db.initializeDatabase());
+    QVERIFY(db.saveUser("frank", "pw"));
+
+    const char* opponents[] = { "AI", "Grace", "grace_hopper", "Heidi" };
+    GameHistoryStore history;
+    GameRecord record;
+    record.moves = {{0, 0, 'X'}};
+    for (int i = 0; i < 40; ++i) {
+        record.opponent = opponents[i % 4];
+        record.mode = record.opponent == "AI" ? "PvAI" : "PvP";
+        record.winner = i % 5 == 0 ? "Draw" : (record.mode == "PvAI" ? "You" : "Player 2");
+        record.timestamp = DatabaseManager::formatTimestamp(QDateTime::currentDateTimeUtc());
+        QVERIFY(db.saveGameRecord("frank", record));
+        history.push_back(record);
+    }
+    QVERIFY(!db.loadGameHistory("frank").front().opponent.isEmpty());
+
+    HistoryFilter filter;
+    filter.mode = "PvP";
+    QCOMPARE(db.countGameHistory("frank", filter), 30);
+    filter.opponent = "GRACE";
+    QCOMPARE(db.countGameHistory("frank", filter), 20);
+    filter.opponent = "grace_";   // '_' is matched literally
+    QCOMPARE(db.countGameHistory("frank", filter), 10);
+    filter = HistoryFilter();
+    filter.winner = "Draw";
+    QCOMPARE(db.countGameHistory("frank", filter), 8);
+    filter.from = QDateTime::currentDateTimeUtc().addDays(1);
+    QCOMPARE(db.countGameHistory("frank", filter), 0);
+    filter.from = QDateTime::currentDateTimeUtc().addDays(-1);
+    filter.to = QDateTime::currentDateTimeUtc().addDays(1);
+    QCOMPARE(db.countGameHistory("frank", filter), 8);
+
+    filter = HistoryFilter();
+    filter.opponent = "gr";
+    GameHistoryModel model;
+    model.setDatabaseSource(&db, "frank");
+    model.setFilter(filter);
+    model.sort(GameHistoryModel::OpponentColumn, Qt::AscendingOrder);
+    QCOMPARE(model.rowCount(), 20);
+    QCOMPARE(model.recordAt(0).opponent, QString("Grace"));
+    QCOMPARE(model.recordAt(19).opponent, QString("grace_hopper"));
+
+    GameHistoryModel memory;
+    memory.setRecords(history.snapshot());
+    memory.setFilter(filter);
+    QCOMPARE(memory.rowCount(), 20);
+    filter.winner = "Draw";
+    memory.setFilter(filter);
+    model.setFilter(filter);
+    QCOMPARE(memory.rowCount(), model.rowCount());
+}
+void TestGameBoard::testGameHistorySnapshots()
+{
+    GameHistoryStore store;
+    GameRecord record;
+    record.mode = "PvAI";
+    record.winner = "You";
+    record.moves = {{0, 0, 'X'}, {1, 1, 'O'}};
+    store.push_back(record);
+    store.push_back(record);
+
+    GameHistoryStore::Snapshot snapshot = store.snapshot();
+    QCOMPARE(snapshot.get(), store.snapshot().get()); // shared, not copied
+    QCOMPARE(&(*snapshot)[0], &store[0]);
+
+    store.push_back(record); // copies once, leaving the snapshot intact
+    QCOMPARE(snapshot->size(), static_cast<size_t>(2));
+    QCOMPARE(store.size(), static_cast<size_t>(3));
+    QVERIFY(snapshot.get() != store.snapshot().get());
+
+    snapshot.reset();
+    const std::vector<GameRecord>* owner = store.snapshot().get();
+    store.push_back(record); // sole owner again: appends in place
+    QCOMPARE(store.size(), static_cast<size_t>(4));
+    QCOMPARE(store.snapshot().get(), owner);
+
+    snapshot = store.snapshot();
+    store.clear();
+    QVERIFY(store.empty());
+    QCOMPARE(snapshot->size(), static_cast<size_t>(4));
+
+    HistoryDialog dialog;
+    dialog.setGameHistory(snapshot);
+    QCOMPARE(snapshot.use_count(), 2L);
+    dialog.show();
+    dialog.hide();
+    QCOMPARE(snapshot.use_count(), 1L);
+}
+void TestGameBoard::testReplayEngine()
+{
+    std::vector<Move> moves = {{0, 0, 'X'}, {1, 1, 'O'}, {0, 1, 'X'}, {2, 2, 'O'}, {0, 2, 'X'}};
+    ReplayEngine engine(moves);
+    QCOMPARE(engine.getPlyCount(), 5);
+    QCOMPARE(engine.getPly(), 0);
+    QVERIFY(engine.getLastMove() == nullptr);
+    QCOMPARE(engine.cellAt(0, 0), ' ');
+
+    QVERIFY(engine.seek(5));
+    QVERIFY(engine.atEnd());
+    QCOMPARE(engine.cellAt(0, 2), 'X');
+    QCOMPARE(engine.cellAt(2, 2), 'O');
+    QCOMPARE(engine.getLastMove()->col, 2);
+    QVERIFY(!engine.stepForward());
+
+    QVERIFY(engine.seek(2));
+    QCOMPARE(engine.cellAt(1, 1), 'O');
+    QCOMPARE(engine.cellAt(0, 1), ' ');
+    QVERIFY(engine.stepBack());
+    QCOMPARE(engine.cellAt(1, 1), ' ');
+    QCOMPARE(engine.cellAt(0, 0), 'X');
+    QVERIFY(!engine.seek(-1));
+    QVERIFY(!engine.seek(6));
+    QCOMPARE(engine.getPly(), 1);
+    QCOMPARE(engine.getSnapshot(5)[0], quint64(0x7)); // X: top row
+
+    engine.setSpeed(4.0);
+    QCOMPARE(engine.getIntervalMs(), ReplayEngine::BaseIntervalMs / 4);
+    engine.setSpeed(1000.0);
+    QCOMPARE(engine.getSpeed(), 16.0);
+
+    // Larger boards use the same encoding.
+    engine.load({{4, 4, 'O'}, {9, 9, 'X'}}, 5);
+    QVERIFY(engine.seek(2));
+    QCOMPARE(engine.cellAt(4, 4), 'O');
+    QCOMPARE(engine.getSnapshot(2)[0], quint64(0)); // off-board move ignored
+
+    // A 15x15 game spans several words per bitset; late moves still land.
+    std::vector<Move> longGame = {{0, 0, 'X'}, {7, 7, 'O'}, {14, 14, 'X'}, {14, 13, 'O'}};
+    QCOMPARE(ReplayEngine::boardSizeFor(longGame), 15);
+    engine.load(longGame, ReplayEngine::boardSizeFor(longGame));
+    QCOMPARE(engine.getWordsPerSide(), 4);
+    QVERIFY(engine.seek(4));
+    QCOMPARE(engine.cellAt(14, 14), 'X');
+    QCOMPARE(engine.cellAt(14, 13), 'O');
+    QCOMPARE(engine.cellAt(7, 7), 'O');
+    QVERIFY(engine.seek(2));
+    QCOMPARE(engine.cellAt(14, 14), ' ');
+
+    ReplayDialog dialog(moves);
+    QCOMPARE(dialog.getEngine().getPly(), 0);
+}
+void TestGameBoard::testReplayPicker()
+{
+    GameRecord record;
+    record.mode = "PvAI";
+    record.winner = "You";
+    record.opponent = "AI";
+    record.moves = {{0, 0, 'X'}, {1, 1, 'O'}};
+    record.timestamp = "2026-01-02 10:00:00";
+    std::vector<GameRecord> history(GameHistoryModel::PageSize + 50, record);
+    history.back().mode = "PvP";
+    history.back().opponent = "Ivan";
+    MainWindow::gameHistory = history;
+
+    GameDialog dialog;
+    QComboBox* comboBox = dialog.findChild<QComboBox*>();
+    QVERIFY(comboBox != nullptr);
+    dialog.on_replayButton_clicked();
+    QCOMPARE(comboBox->count(), GameHistoryModel::PageSize + 1); // placeholder + first page only
+    QVERIFY(comboBox->itemText(1).contains("Ivan"));             // newest first
+
+    QLineEdit* search = dialog.findChild<QLineEdit*>();
+    QVERIFY(search != nullptr);
+    search->setText("pvp");
+    dialog.onReplaySearchChanged();
+    QCOMPARE(comboBox->count(), 2);
+    search->setText("2026-01-02");
+    dialog.onReplaySearchChanged();
+    QCOMPARE(comboBox->count(), GameHistoryModel::PageSize + 1);
+    search->clear();
+    dialog.onReplaySearchChanged();
+
+    MainWindow::gameHistory.push_back(record); // new revision: rebuilt on next open
+    dialog.on_replayButton_clicked();
+    QVERIFY(comboBox->itemText(1).contains("PvAI"));
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    DatabaseManager db(dir.filePath("replay.db"));
+    QVERIFY(db.initializeDatabase());
+    QVERIFY(db.saveUser("judy", "pw"));
+    QVERIFY(db.saveGameRecord("judy", record));
+    GameHistoryModel games;
+    games.setDatabaseSource(&db, "judy");
+    QVERIFY(games.recordAt(0).moves.empty()); // pages carry no moves
+    std::vector<Move> moves = db.loadGameMoves(games.recordAt(0).id);
+    QCOMPARE(moves.size(), record.moves.size());
+    QCOMPARE(moves[1].player, 'O');
+    QVERIFY(db.loadGameMoves(-1).empty());
+}
+void TestGameBoard::testBoardView()
+{
+    BoardView view(3);
+    QCOMPARE(view.size(), QSize(3 * BoardView::MaxCellSize, 3 * BoardView::MaxCellSize));
+    QCOMPARE(view.cellAt(QPoint(85, 5)), QPoint(0, 1));
+    QCOMPARE(view.cellAt(QPoint(239, 239)), QPoint(2, 2));
+    QCOMPARE(view.cellAt(QPoint(240, 10)), QPoint(-1, -1));
+    view.setCell(1, 1, 'O');
+    QCOMPARE(view.getCell(1, 1), 'O');
+    view.clear();
+    QCOMPARE(view.getCell(1, 1), ' ');
+
+    QSignalSpy clicks(&view, &BoardView::cellClicked);
+    QTest::mouseClick(&view, Qt::LeftButton, Qt::NoModifier, view.cellRect(2, 1).center());
+    QCOMPARE(clicks.count(), 1);
+    QCOMPARE(clicks.at(0).at(0).toInt(), 2);
+    QCOMPARE(clicks.at(0).at(1).toInt(), 1);
+    view.setInteractive(false);
+    QTest::mouseClick(&view, Qt::LeftButton, Qt::NoModifier, view.cellRect(0, 0).center());
+    QCOMPARE(clicks.count(), 1);
+
+    view.setBoardSize(15);
+    QCOMPARE(view.getCellSize(), static_cast<int>(BoardView::MinCellSize));
+    QCOMPARE(view.cellAt(view.cellRect(14, 7).center()), QPoint(14, 7));
+
+    // Keyboard play: the cursor starts top-left and stops at the edges.
+    BoardView keys(3);
+    QSignalSpy keyClicks(&keys, &BoardView::cellClicked);
+    QTest::keyClick(&keys, Qt::Key_Up);
+    QTest::keyClick(&keys, Qt::Key_Right);
+    QTest::keyClick(&keys, Qt::Key_Down);
+    QCOMPARE(keys.getCursorCell(), QPoint(1, 1));
+    QTest::keyClick(&keys, Qt::Key_Space);
+    QCOMPARE(keyClicks.count(), 1);
+    QCOMPARE(keyClicks.at(0).at(0).toInt(), 1);
+    QCOMPARE(keyClicks.at(0).at(1).toInt(), 1);
+    QVERIFY(keys.accessibleDescription().startsWith("Row 2, column 2"));
+    keys.setInteractive(false);
+    QTest::keyClick(&keys, Qt::Key_Return);
+    QCOMPARE(keyClicks.count(), 1);
+    QVERIFY(keys.grab().toImage().pixelColor(10, 10) != QColor("#f0f0f0")); // shaded
+
+    GameBoard board(nullptr, 1);
+    BoardView* cells = board.findChild<BoardView*>();
+    QVERIFY(cells != nullptr);
+    size_t moves = MainWindow::clickToMoveMonitor.getMeasurementCount();
+    QTest::mouseClick(cells, Qt::LeftButton, Qt::NoModifier, cells->cellRect(0, 2).center());
+    QCOMPARE(board.getBoard()[0][2], 'X');
+    QCOMPARE(cells->getCell(0, 2), 'X');
+    QCOMPARE(board.getCurrentPlayer(), 'O');
+    QCOMPARE(MainWindow::clickToMoveMonitor.getMeasurementCount(), moves + 1);
+    QVERIFY(cells->getClickNs() > 0);
+    QTest::mouseClick(cells, Qt::LeftButton, Qt::NoModifier, cells->cellRect(0, 2).center()); // occupied
+    QCOMPARE(MainWindow::clickToMoveMonitor.getMeasurementCount(), moves + 1);
+}
+void TestGameBoard::testBoardTheme()
+{
+    QCOMPARE(BoardTheme::stateFor('X'), BoardTheme::XCell);
+    QCOMPARE(BoardTheme::stateFor('O'), BoardTheme::OCell);
+    QCOMPARE(BoardTheme::stateFor(' '), BoardTheme::EmptyCell);
+
+    BoardView view(3);
+    view.setCell(0, 0, 'X');
+    QImage image = view.grab().toImage();
+    QCOMPARE(image.pixelColor(10, 10), QColor("#87CEFA"));
+    QCOMPARE(image.pixelColor(view.cellRect(1, 1).topLeft() + QPoint(10, 10)), QColor("#f0f0f0"));
+
+    BoardTheme dark = BoardTheme::classic();
+    dark.background[BoardTheme::XCell] = QBrush(Qt::darkBlue);
+    dark.background[BoardTheme::EmptyCell] = QBrush(Qt::black);
+    view.setTheme(dark);
+    image = view.grab().toImage();
+    QCOMPARE(image.pixelColor(10, 10), QColor(Qt::darkBlue));
+    QCOMPARE(image.pixelColor(view.cellRect(1, 1).topLeft() + QPoint(10, 10)), QColor(Qt::black));
+    QCOMPARE(BoardTheme::classic().background[BoardTheme::XCell].color(), QColor("#87CEFA"));
+}
+void TestGameBoard::testGameBoardReuse()
+{
+    GameBoard board(nullptr, 1);
+    BoardView* cells = board.findChild<BoardView*>();
+    QVERIFY(board.makeMove(0, 0, 'X'));
+    board.disableBoard();
+
+    board.configure(2);
+    QCOMPARE(board.getGameMode(), 2);
+    QCOMPARE(board.findChild<BoardView*>(), cells); // same widgets
+    QVERIFY(board.isEmpty(0, 0));
+    QCOMPARE(cells->getCell(0, 0), ' ');
+    QVERIFY(cells->isInteractive());
+    QCOMPARE(board.getCurrentPlayer(), 'X');
+
+    // A pending AI reply must not leak into the next game.
+    QVERIFY(board.makeMove(1, 1, 'X'));
+    board.switchPlayer();
+    board.configure(1);
+    QTest::qWait(250);
+    for (const auto& row : board.getBoard())
+        for (char cell : row)
+            QCOMPARE(cell, ' ');
+
+    board.configure(2);
+    QVERIFY(board.makeMove(1, 1, 'X'));
+    board.switchPlayer();
+    QTRY_COMPARE(board.getCurrentPlayer(), 'X'); // the AI replied
+}
+void TestGameBoard::testNonBlockingGameOver()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    DatabaseManager db(dir.filePath("gameover.db"));
+    QVERIFY(db.initializeDatabase());
+    QVERIFY(db.saveUser("kim", "pw"));
+    DatabaseManager* previousManager = MainWindow::dbManager;
+    QString previousUser = MainWindow::currentUser;
+    MainWindow::dbManager = &db;
+    MainWindow::currentUser = "kim";
+    MainWindow::gameHistory.clear();
+
+    {
+        GameDialog dialog;
+        GamePersister* persister = dialog.findChild<GamePersister*>();
+        QVERIFY(persister != nullptr);
+        dialog.recordMove(0, 0, 'X');
+        dialog.onGameOver("Draw"); // returns without a message box to dismiss
+        QCOMPARE(MainWindow::gameHistory.size(), static_cast<size_t>(1));
+        QVERIFY(!MainWindow::gameMetrics.isGameInProgress()); // timed again from the next first move
+
+        QPushButton* details = nullptr;
+        for (QPushButton* button : dialog.findChildren<QPushButton*>())
+            if (button->text() == "Details")
+                details = button;
+        QVERIFY(details != nullptr);
+        QVERIFY(details->parentWidget()->isVisibleTo(&dialog)); // results shown in place
+
+        QTRY_COMPARE(persister->pendingCount(), 0);
+        QCOMPARE(db.loadGameHistory("kim").size(), static_cast<size_t>(1));
+        QCOMPARE(db.loadUserStats("kim").draws, 1);
+
+        for (int i = 0; i < 3; ++i)
+            dialog.onGameOver("Draw");
+    } // games still queued are saved before the dialog goes
+
+    QCOMPARE(db.loadGameHistory("kim").size(), static_cast<size_t>(4));
+    QCOMPARE(db.getConnectionCount(), 1); // the worker's connection was released
+    MainWindow::dbManager = previousManager;
+    MainWindow::currentUser = previousUser;
+    MainWindow::gameHistory.clear();
+}
+void TestGameBoard::benchmarkDatabaseProfiles_data()
+{
+    QTest::addColumn<QString>("profile");
+    QTest::newRow("durable") << QString("durable");
+    QTest::newRow("balanced") << QString("balanced");
+    QTest::newRow("fast") << QString("fast");
+}
+void TestGameBoard::benchmarkDatabaseProfiles()
+{
+    QFETCH(QString, profile);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    DatabaseManager db(dir.filePath("bench.db"), DatabaseProfile::fromName(profile));
+    QVERIFY(db.initializeDatabase());
+    QVERIFY(db.saveUser("bench", "secret"));
+
+    GameRecord record;
+    record.mode = "PvAI";
+    record.winner = "AI";
+    record.moves = {{0, 0, 'X'}, {1, 1, 'O'}, {0, 1, 'X'}, {0, 2, 'O'}, {2, 0, 'O'}};
+
+    const int inserts = 200;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < inserts; ++i)
+        QVERIFY(db.saveGameRecord("bench", record));
+    double insertMs = timer.nsecsElapsed() / 1000000.0;
+
+    const int queries = 20;
+    timer.start();
+    for (int i = 0; i < queries; ++i)
+        QCOMPARE(db.loadGameHistory("bench").size(), static_cast<size_t>(inserts));
+    double queryMs = timer.nsecsElapsed() / 1000000.0;
+
+    qInfo().noquote() << QString("%1: %2 inserts/s, %3 history loads/s")
+                             .arg(profile, -8)
+                             .arg(inserts * 1000.0 / insertMs, 0, 'f', 0)
+                             .arg(queries * 1000.0 / queryMs, 0, 'f', 1);
+}
+
+QTEST_MAIN(TestGameBoard)
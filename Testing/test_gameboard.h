@@ -19,5 +19,29 @@ private slots:
     void testFullTurnCycle();
     void testAIIntegration();
     void testReplayIntegration();
+    void testPreparedStatementReuse();
+    void testDatabaseOperationStats();
+    void testUserStatsMaintainedOnInsert();
+    void testConcurrentDatabaseAccess();
+    void testResourceSampling();
+    void testLatencyHistogram();
+    void testScopedProbes();
+    void testChromeTraceExport();
+    void testMetricsEndpoint();
+    void testMetricsExport();
+    void testGameMetricsAccounting();
+    void testMoveTimings();
+    void testAllocationTracking();
+    void testHistoryModelPaging();
+    void testHistoryFiltering();
+    void testGameHistorySnapshots();
+    void testReplayEngine();
+    void testReplayPicker();
+    void testBoardView();
+    void testBoardTheme();
+    void testGameBoardReuse();
+    void testNonBlockingGameOver();
+    void benchmarkDatabaseProfiles_data();
+    void benchmarkDatabaseProfiles();
 };
 #endif // TEST_GAMEBOARD_H
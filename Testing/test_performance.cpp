@@ -0,0 +1,206 @@
+#include "test_performance.h"
+
+#ifndef TICTACTOE_PERF_BASELINE
+#define TICTACTOE_PERF_BASELINE "performance_baseline.json"
+#endif
+
+// Fixed integer work whose duration tracks single-core speed.
+static double runCalibration()
+{
+    double best = 0.0;
+    for (int run = 0; run < 3; ++run) {
+        QElapsedTimer timer;
+        timer.start();
+        quint64 hash = 1469598103934665603ULL;
+        for (quint32 i = 0; i < 20000000; ++i)
+            hash = (hash ^ i) * 1099511628211ULL;
+        volatile quint64 sink = hash;
+        Q_UNUSED(sink);
+        double elapsed = timer.nsecsElapsed() / 1000000.0;
+        if (run == 0 || elapsed < best)
+            best = elapsed;
+    }
+    return best;
+}
+
+void TestPerformance::initTestCase()
+{
+    baselinePath = qEnvironmentVariable("TICTACTOE_PERF_BASELINE", TICTACTOE_PERF_BASELINE);
+    QFile file(baselinePath);
+    if (file.open(QIODevice::ReadOnly))
+        baseline = QJsonDocument::fromJson(file.readAll()).object();
+    else
+        qWarning() << "No performance baseline at" << baselinePath << "- recording only";
+
+    calibrationMs = runCalibration();
+    double baselineCalibration = baseline["calibrationMs"].toDouble();
+    if (baselineCalibration > 0.0)
+        speedFactor = calibrationMs / baselineCalibration;
+    qInfo().noquote() << QString("Calibration: %1 ms (baseline %2 ms, speed factor %3)")
+                             .arg(calibrationMs, 0, 'f', 2)
+                             .arg(baselineCalibration, 0, 'f', 2)
+                             .arg(speedFactor, 0, 'f', 2);
+}
+
+void TestPerformance::checkAgainstBaseline(const QString& workload, const PerformanceMonitor& monitor)
+{
+    double p50 = monitor.getPercentile(50);
+    QJsonObject result;
+    result["count"] = static_cast<double>(monitor.getMeasurementCount());
+    result["p50Ms"] = p50;
+    result["p99Ms"] = monitor.getPercentile(99);
+    result["maxMs"] = monitor.getMaxTime();
+
+    QJsonObject expected = baseline["workloads"].toObject()[workload].toObject();
+    if (expected.isEmpty()) {
+        qInfo().noquote() << QString("%1: p50 %2 ms (no baseline)").arg(workload).arg(p50, 0, 'f', 4);
+        results[workload] = result;
+        return;
+    }
+
+    double tolerance = expected.contains("tolerance") ? expected["tolerance"].toDouble()
+                                                      : baseline["defaultTolerance"].toDouble(0.5);
+    double scaledBaseline = expected["p50Ms"].toDouble() * speedFactor;
+    double allowed = scaledBaseline * (1.0 + tolerance);
+    result["baselineP50Ms"] = scaledBaseline;
+    result["allowedP50Ms"] = allowed;
+    result["ratio"] = scaledBaseline > 0.0 ? p50 / scaledBaseline : 0.0;
+    bool gated = expected["gate"].toBool(true);
+    result["gated"] = gated;
+    results[workload] = result;
+
+    QString line = QString("%1: p50 %2 ms, baseline %3 ms, allowed %4 ms")
+                       .arg(workload)
+                       .arg(p50, 0, 'f', 4)
+                       .arg(scaledBaseline, 0, 'f', 4)
+                       .arg(allowed, 0, 'f', 4);
+    qInfo().noquote() << line;
+    if (p50 <= allowed)
+        return;
+    if (!gated) {
+        qWarning().noquote() << "Over budget (report only): " + line;
+        return;
+    }
+    regressions << line;
+    QFAIL(qPrintable("Performance regression: " + line));
+}
+
+void TestPerformance::testAiSearch()
+{
+    // The AI's reply to a corner opening searches the deepest tree it
+    // ever meets in a real game.
+    GameBoard board(nullptr, 2);
+    for (int i = 0; i < 15; ++i) {
+        board.resetBoard();
+        QVERIFY(board.makeMove(0, 0, 'X'));
+        board.switchPlayer();
+        board.aiMove();
+        QCOMPARE(board.getCurrentPlayer(), 'X');
+    }
+    checkAgainstBaseline("ai.findBestMove", board.getAiPerformanceMonitor());
+}
+
+static GameRecord fullGameRecord()
+{
+    GameRecord record;
+    record.mode = "PvAI";
+    record.winner = "Draw";
+    record.moves = {{0, 0, 'X', 900, 900.0}, {1, 1, 'O', 1010, 8.4}, {0, 1, 'X', 2500, 1490.0},
+                    {0, 2, 'O', 2610, 1.2}, {2, 0, 'X', 4100, 1490.0}, {1, 0, 'O', 4200, 0.4},
+                    {1, 2, 'X', 5600, 1400.0}, {2, 1, 'O', 5700, 0.1}, {2, 2, 'X', 7000, 1300.0}};
+    return record;
+}
+
+void TestPerformance::testDatabaseInsert()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    DatabaseManager db(dir.filePath("perf.db"));
+    QVERIFY(db.initializeDatabase());
+    QVERIFY(db.saveUser("perf", "secret"));
+
+    GameRecord record = fullGameRecord();
+    PerformanceMonitor monitor("db.saveGameRecord");
+    for (int i = 0; i < 200; ++i) {
+        monitor.startMeasurement();
+        QVERIFY(db.saveGameRecord("perf", record));
+        monitor.stopMeasurement();
+    }
+    checkAgainstBaseline("db.saveGameRecord", monitor);
+}
+
+void TestPerformance::testHistoryLoad()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    DatabaseManager db(dir.filePath("perf.db"));
+    QVERIFY(db.initializeDatabase());
+    QVERIFY(db.saveUser("perf", "secret"));
+    GameRecord record = fullGameRecord();
+    for (int i = 0; i < 200; ++i)
+        QVERIFY(db.saveGameRecord("perf", record));
+
+    PerformanceMonitor monitor("db.loadGameHistory");
+    for (int i = 0; i < 30; ++i) {
+        monitor.startMeasurement();
+        std::vector<GameRecord> history = db.loadGameHistory("perf");
+        monitor.stopMeasurement();
+        QCOMPARE(history.size(), static_cast<size_t>(200));
+    }
+    checkAgainstBaseline("db.loadGameHistory", monitor);
+}
+
+void TestPerformance::testMoveSerialization()
+{
+    GameRecord record = fullGameRecord();
+    PerformanceMonitor monitor("serialization.moves");
+    for (int i = 0; i < 2000; ++i) {
+        monitor.startMeasurement();
+        std::vector<Move> parsed = DatabaseManager::parseMoves(DatabaseManager::serializeMoves(record.moves));
+        monitor.stopMeasurement();
+        QCOMPARE(parsed.size(), record.moves.size());
+    }
+    checkAgainstBaseline("serialization.moves", monitor);
+}
+
+void TestPerformance::cleanupTestCase()
+{
+    QJsonObject report;
+    report["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+    report["build"] = MetricsExporter::buildMetadata();
+    report["calibrationMs"] = calibrationMs;
+    report["speedFactor"] = speedFactor;
+    report["workloads"] = results;
+    report["regressions"] = QJsonArray::fromStringList(regressions);
+
+    QString reportPath = qEnvironmentVariable("TICTACTOE_PERF_REPORT", "performance_report.json");
+    QSaveFile reportFile(reportPath);
+    if (reportFile.open(QIODevice::WriteOnly)) {
+        reportFile.write(QJsonDocument(report).toJson());
+        if (reportFile.commit())
+            qInfo() << "Performance report written to" << reportPath;
+    }
+
+    if (qEnvironmentVariableIntValue("TICTACTOE_PERF_UPDATE_BASELINE") != 1)
+        return;
+
+    QJsonObject workloads = baseline["workloads"].toObject();
+    for (auto it = results.constBegin(); it != results.constEnd(); ++it) {
+        QJsonObject entry = workloads[it.key()].toObject();
+        entry["p50Ms"] = it.value().toObject()["p50Ms"].toDouble();
+        workloads[it.key()] = entry;
+    }
+    baseline["calibrationMs"] = calibrationMs;
+    baseline["workloads"] = workloads;
+    if (!baseline.contains("defaultTolerance"))
+        baseline["defaultTolerance"] = 0.5;
+
+    QSaveFile baselineFile(baselinePath);
+    if (baselineFile.open(QIODevice::WriteOnly)) {
+        baselineFile.write(QJsonDocument(baseline).toJson());
+        if (baselineFile.commit())
+            qInfo() << "Performance baseline updated:" << baselinePath;
+    }
+}
+
+QTEST_MAIN(TestPerformance)
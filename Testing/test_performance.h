@@ -0,0 +1,40 @@
+#ifndef TEST_PERFORMANCE_H
+#define TEST_PERFORMANCE_H
+
+#include <QObject>
+#include <QtTest>
+#include "mainwindow.h"
+
+// Performance regression gate: fixed AI, database and serialization
+// workloads are timed and their medians compared with the stored baseline
+// (Testing/performance_baseline.json), scaled by a CPU calibration loop
+// so slower machines are not flagged. A workload fails when it exceeds
+// its scaled baseline by more than the tolerance, unless its entry has
+// "gate": false, in which case it is only reported. The calibration does
+// not scale disk-bound work, so the database entries stay report-only
+// until they are measured on the reference machine. Setting
+// TICTACTOE_PERF_UPDATE_BASELINE=1 rewrites the baseline medians from this
+// run and leaves each entry's gate flag as it was.
+class TestPerformance : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testAiSearch();
+    void testDatabaseInsert();
+    void testHistoryLoad();
+    void testMoveSerialization();
+    void cleanupTestCase();
+
+private:
+    void checkAgainstBaseline(const QString& workload, const PerformanceMonitor& monitor);
+
+    QString baselinePath;
+    QJsonObject baseline;
+    double calibrationMs = 0.0;
+    double speedFactor = 1.0;
+    QJsonObject results;
+    QStringList regressions;
+};
+#endif // TEST_PERFORMANCE_H
@@ -0,0 +1,31 @@
+QT += core widgets sql network testlib
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = test_performance
+INCLUDEPATH += ../Include
+
+# Regression gate: `make check` runs it; see test_performance.h.
+DEFINES += TICTACTOE_PERF_BASELINE=\\\"$$PWD/performance_baseline.json\\\"
+
+# Heap accounting per subsystem: qmake CONFIG+=alloc_tracking
+alloc_tracking: DEFINES += TICTACTOE_ALLOC_TRACKING
+
+# SQLite engine counters, only with a -system-sqlite Qt: qmake CONFIG+=sqlite_stats
+sqlite_stats {
+    CONFIG += link_pkgconfig
+    PKGCONFIG += sqlite3
+    DEFINES += TICTACTOE_SQLITE_STATS
+}
+
+SOURCES += \
+    test_performance.cpp \
+    ../Src/mainwindow.cpp
+
+HEADERS += \
+    test_performance.h \
+    ../Include/mainwindow.h
+
+FORMS += \
+    ../UI/mainwindow.ui